@@ -0,0 +1,174 @@
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BenchUtils
+{
+struct BenchmarkResult {
+    std::string name;
+    long iterations = 0;
+    double nanosecondsPerIteration = 0.0;
+    double itemsPerSecond = 0.0;
+};
+
+/**
+ * @brief Prevents the compiler from optimizing away a benchmarked value
+ */
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Measures the average cost of one call of a function
+ *
+ * @param iterations Number of times the function is called
+ * @param function Function to measure
+ * @return double Average nanoseconds per call
+ */
+template <typename Function>
+double measureNanosecondsPerCall(long iterations, Function &&function)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+/**
+ * @brief Measures a function with as many iterations as fit into a minimum run time
+ *
+ * @param name Name of the benchmark in the report, cases are separated by slashes
+ * @param itemsPerIteration Number of items, e.g. ticks or spawns, one call processes
+ * @param function Function to measure, called with the index of the iteration
+ * @param minSeconds Run time the iteration count is doubled up to
+ * @return BenchmarkResult Measurement of the final run
+ */
+template <typename Function>
+BenchmarkResult measure(const std::string &name, double itemsPerIteration, Function &&function,
+    double minSeconds = 0.2)
+{
+    BenchmarkResult result;
+    result.name = name;
+    for (long iterations = 1;; iterations *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < iterations; i++) {
+            function(i);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds >= minSeconds || iterations >= (1L << 40)) {
+            result.iterations = iterations;
+            result.nanosecondsPerIteration = seconds * 1e9 / iterations;
+            result.itemsPerSecond = seconds > 0.0 ? itemsPerIteration * iterations / seconds : 0.0;
+            return result;
+        }
+    }
+}
+
+/**
+ * @brief Gets the path given with --json, or an empty string to only print the results
+ */
+inline std::string getJsonPath(int argc, char **argv)
+{
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--json") == 0) return argv[i + 1];
+    }
+    return "";
+}
+
+/**
+ * @brief Collects the results of a benchmark suite, prints them and writes them as JSON
+ *
+ * The JSON file follows the layout of Google Benchmark's output, a context object and a
+ * benchmarks array with times in nanoseconds, so its comparison scripts work on it.
+ */
+class BenchmarkReport
+{
+   private:
+    std::string suite;
+    std::vector<BenchmarkResult> results;
+
+    /**
+     * @brief Writes a string as a JSON string literal
+     */
+    static void writeJsonString(FILE *file, const std::string &text)
+    {
+        std::fputc('"', file);
+        for (char c : text) {
+            if (c == '"' || c == '\\') std::fputc('\\', file);
+            std::fputc(c, file);
+        }
+        std::fputc('"', file);
+    }
+
+   public:
+    /**
+     * @brief Starts a report and prints the table header
+     *
+     * @param suite Name of the suite in the JSON context
+     */
+    BenchmarkReport(const std::string &suite) : suite(suite)
+    {
+        std::printf("%-44s %14s %12s %16s\n", "benchmark", "ns/iteration", "iterations", "items/s");
+    }
+
+    /**
+     * @brief Adds a result and prints it
+     */
+    void add(const BenchmarkResult &result)
+    {
+        std::printf("%-44s %14.1f %12ld %16.0f\n", result.name.c_str(), result.nanosecondsPerIteration,
+            result.iterations, result.itemsPerSecond);
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+
+    /**
+     * @brief Writes all results into a JSON file
+     *
+     * @return true if the file was written
+     */
+    bool writeJson(const std::string &path) const
+    {
+        FILE *file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) return false;
+
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+        const char *buildType = "release";
+#else
+        const char *buildType = "debug";
+#endif
+
+        std::fprintf(file, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"suite\": ", date);
+        writeJsonString(file, suite);
+        std::fprintf(file, ",\n    \"num_cpus\": %u,\n    \"library_build_type\": \"%s\"\n  },\n  \"benchmarks\": [",
+            std::thread::hardware_concurrency(), buildType);
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult &result = results[i];
+            std::fprintf(file, "%s\n    {\n      \"name\": ", i == 0 ? "" : ",");
+            writeJsonString(file, result.name);
+            std::fprintf(file,
+                ",\n      \"run_type\": \"iteration\",\n      \"iterations\": %ld,\n      \"real_time\": %.3f,\n"
+                "      \"time_unit\": \"ns\",\n      \"items_per_second\": %.3f\n    }",
+                result.iterations, result.nanosecondsPerIteration, result.itemsPerSecond);
+        }
+        std::fprintf(file, "\n  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+};
+}  // namespace BenchUtils
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file draw_benchmark.cpp
+ * @brief Benchmark for the cost of drawing a full frame of the game
+ *
+ * Opens a hidden window and draws the menu and the playing screen of a Game into an
+ * offscreen render texture, for the default view and a large one. Ending the texture mode
+ * submits the batched draw calls, so a frame includes building and submitting its
+ * geometry, but not waiting for the GPU to finish rendering it.
+ *
+ * The cell cases draw the cells of a 10000 segment snake once with a DrawRectangle call per
+ * cell and once through a CellBatch, the way the game draws the snake. The speedup of the
+ * batch is printed after the table.
+ *
+ * The font cases load the game's fonts like a startup does: rasterized from the TTF
+ * files, and from a warm font atlas cache, for regular and distance field fonts. The cold
+ * and cached startup times are compared after the table.
+ *
+ * Usage: draw_benchmark [--json <path>]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "../include/cell_batch.h"
+#include "../include/font_manager.h"
+#include "../include/game.h"
+#include "../include/screen_manager.h"
+#include "../include/sound_manager.h"
+#include "bench_utils.h"
+#include "raylib.h"
+
+namespace
+{
+/**
+ * @brief Prints the time of a case next to the time of the case it replaces
+ *
+ * @param label Name of the comparison in the output
+ * @param before Result of the previous way, e.g. immediate drawing
+ * @param after Result of the new way
+ */
+void printSpeedup(const char *label, const BenchUtils::BenchmarkResult &before,
+    const BenchUtils::BenchmarkResult &after)
+{
+    double beforeMilliseconds = before.nanosecondsPerIteration / 1e6;
+    double afterMilliseconds = after.nanosecondsPerIteration / 1e6;
+    double speedup = afterMilliseconds > 0.0 ? beforeMilliseconds / afterMilliseconds : 0.0;
+    std::printf("%s: %.3f ms before, %.3f ms after, %.1fx\n", label, beforeMilliseconds, afterMilliseconds, speedup);
+}
+
+/**
+ * @brief Measures drawing one screen of a game with a view of a number of cells
+ *
+ * @param playing Whether to draw the playing screen instead of the menu
+ */
+BenchUtils::BenchmarkResult measureFrame(
+    const FontManager &fonts, SoundManager &sounds, int viewWidth, int viewHeight, bool playing)
+{
+    GameConfig config;
+    config.cellAmountX = std::max(config.cellAmountX, viewWidth);
+    config.cellAmountY = std::max(config.cellAmountY, viewHeight);
+    config.viewCellAmountX = viewWidth;
+    config.viewCellAmountY = viewHeight;
+    float width = viewWidth * config.cellSize;
+    float height = viewHeight * config.cellSize;
+
+    ScreenManager screens(fonts, Rectangle{0, 0, width, height});
+    Game game(screens, sounds, config, 42);
+    if (playing) {
+        Replay replay;
+        replay.seed = 42;
+        replay.config = config;
+        game.startReplay(replay);
+    }
+
+    RenderTexture2D target = LoadRenderTexture((int) width, (int) height);
+    std::string name = std::string("draw/") + (playing ? "playing/" : "menu/") + std::to_string(viewWidth) + "x" +
+                       std::to_string(viewHeight);
+    BenchUtils::BenchmarkResult result = BenchUtils::measure(name, 1.0, [&](long) {
+        BeginTextureMode(target);
+        ClearBackground(RAYWHITE);
+        game.draw();
+        EndTextureMode();
+    });
+    UnloadRenderTexture(target);
+    return result;
+}
+
+/**
+ * @brief Measures drawing a number of cells laid out row by row on a board of 8 pixel cells
+ *
+ * @param batched Whether to draw through a CellBatch instead of one DrawRectangle call per cell
+ */
+BenchUtils::BenchmarkResult measureCells(int count, bool batched)
+{
+    constexpr int CELL_SIZE = 8;
+    constexpr int COLUMNS = 125;
+    int rows = (count + COLUMNS - 1) / COLUMNS;
+    CellBatch batch;
+    batch.reserve(count);
+
+    RenderTexture2D target = LoadRenderTexture(COLUMNS * CELL_SIZE, rows * CELL_SIZE);
+    std::string name = std::string("cells/") + (batched ? "batched/" : "immediate/") + std::to_string(count);
+    BenchUtils::BenchmarkResult result = BenchUtils::measure(name, count, [&](long) {
+        BeginTextureMode(target);
+        ClearBackground(RAYWHITE);
+        batch.clear();
+        for (int i = 0; i < count; i++) {
+            float x = (float) (i % COLUMNS * CELL_SIZE);
+            float y = (float) (i / COLUMNS * CELL_SIZE);
+            Rectangle cell = {x, y, CELL_SIZE, CELL_SIZE};
+            if (batched) {
+                batch.add(cell, DARKGREEN);
+            } else {
+                DrawRectangleRec(cell, DARKGREEN);
+            }
+        }
+        batch.submit();
+        EndTextureMode();
+    });
+    UnloadRenderTexture(target);
+    return result;
+}
+
+/**
+ * @brief Measures loading the game's fonts
+ *
+ * @param cacheDirectory Directory of the font atlas cache, filled before measuring, or empty to rasterize
+ * @param sdf Whether to load distance field fonts
+ */
+BenchUtils::BenchmarkResult measureFonts(const std::string &cacheDirectory, bool sdf)
+{
+    if (!cacheDirectory.empty()) {
+        FontManager fonts;
+        fonts.initFonts(cacheDirectory, sdf);
+    }
+
+    std::string name = std::string("fonts/") + (cacheDirectory.empty() ? "rasterize" : "cached") + (sdf ? "_sdf" : "");
+    return BenchUtils::measure(name, 2.0, [&](long) {
+        FontManager fonts;
+        fonts.initFonts(cacheDirectory, sdf);
+    });
+}
+}  // namespace
+
+/**
+ * @brief Runs all draw benchmarks and optionally writes the results as JSON
+ *
+ * @param argc Number of command line arguments
+ * @param argv --json <path> to write the results into a file
+ * @return int 0 on success, 1 if the JSON file could not be written
+ */
+int main(int argc, char **argv)
+{
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(640, 480, "Evil Snake draw benchmark");
+
+    std::string jsonPath = BenchUtils::getJsonPath(argc, argv);
+    bool written = true;
+    {
+        FontManager fonts;
+        fonts.initFonts();
+        SoundManager sounds;
+        BenchUtils::BenchmarkReport report("draw");
+
+        for (bool playing : {false, true}) {
+            report.add(measureFrame(fonts, sounds, 25, 15, playing));
+            report.add(measureFrame(fonts, sounds, 100, 60, playing));
+        }
+        BenchUtils::BenchmarkResult cells[2];
+        for (bool batched : {false, true}) {
+            cells[batched] = measureCells(10000, batched);
+            report.add(cells[batched]);
+        }
+
+        std::string cacheDirectory = (std::filesystem::temp_directory_path() / "evilsnake_bench_fonts").string();
+        BenchUtils::BenchmarkResult fontLoads[2][2];
+        for (bool sdf : {false, true}) {
+            fontLoads[sdf][0] = measureFonts("", sdf);
+            report.add(fontLoads[sdf][0]);
+            fontLoads[sdf][1] = measureFonts(cacheDirectory, sdf);
+            report.add(fontLoads[sdf][1]);
+        }
+        std::error_code error;
+        std::filesystem::remove_all(cacheDirectory, error);
+
+        printSpeedup("cells/10000", cells[false], cells[true]);
+        printSpeedup("fonts", fontLoads[false][0], fontLoads[false][1]);
+        printSpeedup("fonts_sdf", fontLoads[true][0], fontLoads[true][1]);
+        written = jsonPath.empty() || report.writeJson(jsonPath);
+    }
+
+    CloseWindow();
+    if (!written) {
+        std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
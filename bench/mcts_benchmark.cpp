@@ -0,0 +1,72 @@
+/**
+ * @file mcts_benchmark.cpp
+ * @brief Benchmark for the playout rate of the MctsBot
+ *
+ * Searches a mid-game position of the default rules, reached by letting the autopilot
+ * play for a while, for several thread counts and reports playouts per second and the
+ * speedup over one thread.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "../include/autopilot.h"
+#include "../include/mcts_bot.h"
+#include "bench_utils.h"
+
+namespace
+{
+/**
+ * @brief Plays a game with the autopilot for a number of ticks
+ */
+SnakeSim createMidGame(int ticks)
+{
+    SnakeSim sim(GameConfig{}, 42);
+    Autopilot autopilot(sim.getGrid());
+    for (int tick = 0; tick < ticks && sim.getStatus() == SimStatus::RUNNING; tick++) {
+        sim.step(autopilot.chooseDirection(sim));
+    }
+    return sim;
+}
+
+/**
+ * @brief Runs a number of searches with a fixed budget
+ *
+ * @return double Playouts per second over all threads
+ */
+double measurePlayouts(const SnakeSim &sim, int threadCount, std::chrono::milliseconds budget, int searches)
+{
+    MctsBot bot(threadCount, 7);
+    long playouts = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < searches; i++) {
+        BenchUtils::doNotOptimize(bot.chooseDirection(sim, budget));
+        playouts += bot.getPlayoutCount();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return playouts / std::chrono::duration<double>(end - start).count();
+}
+}  // namespace
+
+/**
+ * @brief Prints playouts per second for 1 up to all hardware threads
+ */
+int main()
+{
+    const std::chrono::milliseconds budget(100);
+    const int searches = 10;
+    int maxThreads = std::max((int) std::thread::hardware_concurrency(), 1);
+    SnakeSim sim = createMidGame(500);
+
+    std::printf("position: score %d, length %d\n", sim.getScore(), sim.getSnake().body.size());
+    std::printf("%8s %16s %9s\n", "threads", "playouts/s", "speedup");
+    double singleRate = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double rate = measurePlayouts(sim, threads, budget, searches);
+        if (threads == 1) singleRate = rate;
+        std::printf("%8d %16.0f %8.1fx\n", threads, rate, rate / singleRate);
+    }
+    return 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file sim_benchmark.cpp
+ * @brief Benchmark suite for the hot paths of the simulation core
+ *
+ * Covers:
+ * - Tick throughput of SnakeSim::step() for several snake lengths
+ * - Spawning a free cell with SpawnUtils::getRandomFreePosition() under high occupancy
+ * - Collision checks against many walls, occupancy grid against the previous wall list scan
+ * - Encoding, decoding and re-simulating a long replay
+ *
+ * Long snakes are grown by the autopilot on a large board. Tick cases then replay the next
+ * moves of the autopilot from a snapshot, restoring the snapshot every MOVE_COUNT ticks,
+ * so the measured ticks contain no bot time.
+ *
+ * Usage: sim_benchmark [--json <path>]
+ */
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../include/autopilot.h"
+#include "../include/replay.h"
+#include "../include/snake_sim.h"
+#include "../include/spawn_utils.h"
+#include "bench_utils.h"
+
+namespace
+{
+/**
+ * @brief Number of recorded moves a tick case replays before restoring its snapshot
+ */
+constexpr int MOVE_COUNT = 1024;
+
+/**
+ * @brief Creates the rules of a board without walls that cannot be won before it is full
+ */
+GameConfig createOpenConfig(int width, int height)
+{
+    GameConfig config;
+    config.cellAmountX = width;
+    config.cellAmountY = height;
+    config.winningScore = width * height;
+    config.wallAmount = 0;
+    return config;
+}
+
+/**
+ * @brief Plays with the autopilot until the snake has a length
+ */
+SnakeSim growSnake(const GameConfig &config, int length)
+{
+    SnakeSim sim(config, 42);
+    Autopilot autopilot(sim.getGrid(), std::chrono::seconds(1));
+    while (sim.getStatus() == SimStatus::RUNNING && sim.getSnake().body.size() < length) {
+        sim.step(autopilot.chooseDirection(sim));
+    }
+    return sim;
+}
+
+/**
+ * @brief Measures ticks per second for a snake of a length
+ */
+BenchUtils::BenchmarkResult measureTicks(int length)
+{
+    SnakeSim snapshot = growSnake(createOpenConfig(64, 64), length);
+    std::vector<Direction> moves;
+    SnakeSim sim = snapshot;
+    Autopilot autopilot(sim.getGrid(), std::chrono::seconds(1));
+    while ((int) moves.size() < MOVE_COUNT && sim.getStatus() == SimStatus::RUNNING) {
+        moves.push_back(autopilot.chooseDirection(sim));
+        sim.step(moves.back());
+    }
+
+    return BenchUtils::measure("tick/length_" + std::to_string(length), 1.0, [&](long i) {
+        int move = (int) (i % moves.size());
+        if (move == 0) sim = snapshot;
+        BenchUtils::doNotOptimize(sim.step(moves[move]));
+    });
+}
+
+/**
+ * @brief Measures spawning a free cell on a board with a share of occupied cells
+ *
+ * @param occupiedPercent Occupied share of the board, the last free cell is kept free at 100
+ */
+BenchUtils::BenchmarkResult measureSpawn(int width, int height, int occupiedPercent)
+{
+    Grid grid(width, height);
+    FreeCellIndex freeCells(grid.getCellCount());
+    int occupied = std::min(grid.getCellCount() * occupiedPercent / 100, grid.getCellCount() - 1);
+    for (int cell = 0; cell < occupied; cell++) {
+        freeCells.occupy(cell);
+    }
+
+    Random rng(42);
+    std::string name = "spawn/" + std::to_string(width) + "x" + std::to_string(height) + "/occupied_" +
+                       std::to_string(occupiedPercent);
+    return BenchUtils::measure(name, 1.0, [&](long) {
+        BenchUtils::doNotOptimize(SpawnUtils::getRandomFreePosition(rng, grid, freeCells));
+    });
+}
+
+/**
+ * @brief Plays until the walls mode has placed its walls
+ *
+ * Mode changes are checked every tick, so the walls mode comes up within a few ticks.
+ */
+SnakeSim createWallBoard(int wallAmount)
+{
+    GameConfig config = createOpenConfig(64, 64);
+    config.wallAmount = wallAmount;
+    config.eventInterval = config.defaultSnakeSpeed;
+    for (uint64_t seed = 1;; seed++) {
+        SnakeSim sim(config, seed);
+        Autopilot autopilot(sim.getGrid());
+        while (sim.getStatus() == SimStatus::RUNNING && sim.getMode() != GameMode::WALLS) {
+            sim.step(autopilot.chooseDirection(sim));
+        }
+        if (sim.getStatus() == SimStatus::RUNNING) return sim;
+    }
+}
+
+/**
+ * @brief Measures checking every cell of the board for a wall or the snake with the occupancy grid
+ */
+BenchUtils::BenchmarkResult measureOccupancyCollision(const SnakeSim &sim)
+{
+    const Grid &grid = sim.getGrid();
+    std::string name = "collision/occupancy/walls_" + std::to_string(sim.getWallPositions().size());
+    return BenchUtils::measure(name, grid.getCellCount(), [&](long) {
+        int blocked = 0;
+        for (int cell = 0; cell < grid.getCellCount(); cell++) {
+            blocked += sim.isBlocked(grid.getCellPosition(cell));
+        }
+        BenchUtils::doNotOptimize(blocked);
+    });
+}
+
+/**
+ * @brief Measures checking every cell of the board for a wall by scanning the wall list
+ *
+ * The collision check of earlier versions, kept here as the baseline.
+ */
+BenchUtils::BenchmarkResult measureWallScanCollision(const SnakeSim &sim)
+{
+    const Grid &grid = sim.getGrid();
+    const std::vector<Position> &walls = sim.getWallPositions();
+    std::string name = "collision/wall_scan/walls_" + std::to_string(walls.size());
+    return BenchUtils::measure(name, grid.getCellCount(), [&](long) {
+        int blocked = 0;
+        for (int cell = 0; cell < grid.getCellCount(); cell++) {
+            Position position = grid.getCellPosition(cell);
+            for (const Position &wall : walls) {
+                if (wall.x == position.x && wall.y == position.y) {
+                    blocked++;
+                    break;
+                }
+            }
+        }
+        BenchUtils::doNotOptimize(blocked);
+    });
+}
+
+/**
+ * @brief Records a complete autopilot game of the default rules as a replay
+ */
+Replay recordReplay()
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "evilsnake_sim_benchmark.esr";
+    SnakeSim sim(createOpenConfig(25, 15), 42);
+    Autopilot autopilot(sim.getGrid());
+    ReplayWriter writer;
+    writer.open(path.string(), sim.getSeed(), sim.getConfig());
+    while (sim.getStatus() == SimStatus::RUNNING) {
+        sim.step(autopilot.chooseDirection(sim));
+        writer.record(sim.getSnake().getDirection());
+    }
+    writer.finish(sim);
+
+    Replay replay;
+    ReplayUtils::load(path.string(), replay);
+    std::filesystem::remove(path);
+    return replay;
+}
+}  // namespace
+
+/**
+ * @brief Runs all benchmarks and optionally writes the results as JSON
+ *
+ * @param argc Number of command line arguments
+ * @param argv --json <path> to write the results into a file
+ * @return int 0 on success, 1 if the JSON file could not be written
+ */
+int main(int argc, char **argv)
+{
+    BenchUtils::BenchmarkReport report("sim");
+
+    for (int length : {10, 100, 1000}) {
+        report.add(measureTicks(length));
+    }
+
+    for (int occupiedPercent : {50, 90, 99, 100}) {
+        report.add(measureSpawn(25, 15, occupiedPercent));
+        report.add(measureSpawn(256, 256, occupiedPercent));
+    }
+
+    for (int wallAmount : {10, 100, 1000}) {
+        SnakeSim sim = createWallBoard(wallAmount);
+        report.add(measureOccupancyCollision(sim));
+        report.add(measureWallScanCollision(sim));
+    }
+
+    Replay replay = recordReplay();
+    std::vector<uint8_t> data = ReplayUtils::encode(replay);
+    double ticks = replay.outcome.ticks;
+    report.add(BenchUtils::measure("replay/encode", ticks, [&](long) {
+        BenchUtils::doNotOptimize(ReplayUtils::encode(replay).size());
+    }));
+    report.add(BenchUtils::measure("replay/decode", ticks, [&](long) {
+        Replay decoded;
+        BenchUtils::doNotOptimize(ReplayUtils::decode(data, decoded));
+    }));
+    report.add(BenchUtils::measure("replay/simulate", ticks, [&](long) {
+        BenchUtils::doNotOptimize(ReplayUtils::simulate(replay, replay.outcome.ticks).ticks);
+    }));
+
+    std::string jsonPath = BenchUtils::getJsonPath(argc, argv);
+    if (!jsonPath.empty() && !report.writeJson(jsonPath)) {
+        std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file spawn_benchmark.cpp
+ * @brief Microbenchmark for spawning food on a partially occupied board
+ *
+ * Compares the previous rejection sampling approach (draw a random cell, scan the
+ * snake body for an overlap, retry) with the FreeCellIndex used by the simulation.
+ * The snake is modelled as the first cells of the board in row-major order, so
+ * the benchmark covers everything from an empty board up to a single free cell.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "../include/free_cell_index.h"
+#include "bench_utils.h"
+
+namespace
+{
+struct Board {
+    const char *name;
+    int width;
+    int height;
+};
+
+/**
+ * @brief Previous spawning approach, kept here as the baseline
+ *
+ * @return int Random cell index that is not part of the snake body
+ */
+int spawnByRejectionSampling(Random &rng, int cellCount, const std::vector<int> &body)
+{
+    int cell;
+    bool onSnake;
+    do {
+        cell = rng.nextInt(0, cellCount - 1);
+        onSnake = false;
+        for (int bodyCell : body) {
+            if (bodyCell == cell) {
+                onSnake = true;
+                break;
+            }
+        }
+    } while (onSnake);
+    return cell;
+}
+
+/**
+ * @brief Runs both spawning approaches for one board and snake length
+ */
+void runCase(const Board &board, int snakeLength)
+{
+    int cellCount = board.width * board.height;
+    Random rng(42);
+
+    std::vector<int> body(snakeLength);
+    FreeCellIndex freeCells(cellCount);
+    for (int cell = 0; cell < snakeLength; cell++) {
+        body[cell] = cell;
+        freeCells.occupy(cell);
+    }
+
+    // Keep each case around the same total amount of work
+    long indexIterations = 1'000'000;
+    double indexNs = BenchUtils::measureNanosecondsPerCall(indexIterations, [&]() {
+        int cell = freeCells.getRandomFreeCell(rng);
+        freeCells.occupy(cell);
+        freeCells.release(cell);
+        BenchUtils::doNotOptimize(cell);
+    });
+
+    double expectedScans = (double) snakeLength * cellCount / (cellCount - snakeLength);
+    if (expectedScans > 5e7) {
+        std::printf("%-10s %10d %8.2f%% %18s %14.1f\n", board.name, snakeLength, 100.0 * snakeLength / cellCount,
+            "skipped", indexNs);
+        return;
+    }
+
+    long rejectionIterations = std::max(10L, (long) (2e8 / std::max(1.0, expectedScans)));
+    rejectionIterations = std::min(rejectionIterations, 1'000'000L);
+    double rejectionNs = BenchUtils::measureNanosecondsPerCall(rejectionIterations, [&]() {
+        BenchUtils::doNotOptimize(spawnByRejectionSampling(rng, cellCount, body));
+    });
+
+    std::printf("%-10s %10d %8.2f%% %18.1f %14.1f\n", board.name, snakeLength, 100.0 * snakeLength / cellCount,
+        rejectionNs, indexNs);
+}
+}  // namespace
+
+/**
+ * @brief Prints the spawn cost in nanoseconds for growing snake lengths on several board sizes
+ */
+int main()
+{
+    const Board boards[] = {{"25x15", 25, 15}, {"256x256", 256, 256}, {"2048x2048", 2048, 2048}};
+    const double fillRatios[] = {0.0, 0.25, 0.5, 0.9, 0.99};
+
+    std::printf("%-10s %10s %9s %18s %14s\n", "board", "length", "occupied", "rejection ns/op", "index ns/op");
+    for (const Board &board : boards) {
+        int cellCount = board.width * board.height;
+        for (double ratio : fillRatios) {
+            runCase(board, std::max(1, (int) (cellCount * ratio)));
+        }
+        runCase(board, cellCount - 1);
+    }
+    return 0;
+}
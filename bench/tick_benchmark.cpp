@@ -0,0 +1,77 @@
+/**
+ * @file tick_benchmark.cpp
+ * @brief Microbenchmark for moving the snake body by one cell
+ *
+ * Compares the previous body storage (vector front-insert followed by pop_back)
+ * with the SnakeBody ring buffer. One tick prepends a new head and drops the tail,
+ * exactly like a move without eating.
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "../include/snake_body.h"
+#include "bench_utils.h"
+
+namespace
+{
+/**
+ * @brief Moves a vector body around for a number of ticks
+ *
+ * @return double Ticks per second
+ */
+double measureVectorBody(int length, long ticks)
+{
+    std::vector<Position> body(length, Position{0, 0});
+    double ns = BenchUtils::measureNanosecondsPerCall(ticks, [&]() {
+        Position head = body.front();
+        head.x += 1;
+        body.insert(body.begin(), head);
+        body.pop_back();
+        BenchUtils::doNotOptimize(body.front());
+    });
+    return 1e9 / ns;
+}
+
+/**
+ * @brief Moves a ring buffer body around for a number of ticks
+ *
+ * @return double Ticks per second
+ */
+double measureRingBufferBody(int length, int capacity, long ticks)
+{
+    SnakeBody body(capacity);
+    body.assign(Position{0, 0});
+    for (int i = 1; i < length; i++) {
+        body.pushFront(Position{0, 0});
+    }
+
+    double ns = BenchUtils::measureNanosecondsPerCall(ticks, [&]() {
+        Position head = body.front();
+        head.x += 1;
+        body.popBack();
+        body.pushFront(head);
+        BenchUtils::doNotOptimize(body.front());
+    });
+    return 1e9 / ns;
+}
+}  // namespace
+
+/**
+ * @brief Prints ticks per second of both body implementations for several snake lengths
+ *
+ * 375 is a completely filled 25x15 board, 10000 requires a large custom grid.
+ */
+int main()
+{
+    const int lengths[] = {10, 100, 375, 10000};
+    const long ticks = 2'000'000;
+
+    std::printf("%8s %18s %18s %9s\n", "length", "vector ticks/s", "ring ticks/s", "speedup");
+    for (int length : lengths) {
+        double vectorRate = measureVectorBody(length, ticks);
+        double ringRate = measureRingBufferBody(length, length, ticks);
+        std::printf("%8d %18.0f %18.0f %8.1fx\n", length, vectorRate, ringRate, ringRate / vectorRate);
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file vec_env_benchmark.cpp
+ * @brief Benchmark for stepping a batch of games with VecSnakeEnv
+ *
+ * Steps 4096 games on the default board with random actions, including the automatic
+ * resets of ended games and writing all observations, for several thread counts.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "../include/vec_snake_env.h"
+#include "bench_utils.h"
+
+namespace
+{
+/**
+ * @brief Steps a batch for a number of steps
+ *
+ * @return double Game steps per second, i.e. batch steps per second times the batch size
+ */
+double measureBatch(int envCount, int threadCount, long steps)
+{
+    VecSnakeEnv env(envCount, GameConfig{}, 42, threadCount);
+    Random rng(7);
+    std::vector<Direction> actions(envCount);
+
+    double ns = BenchUtils::measureNanosecondsPerCall(steps, [&]() {
+        for (Direction &action : actions) {
+            action = (Direction) rng.nextInt(0, 4);
+        }
+        env.step(actions.data());
+        BenchUtils::doNotOptimize(env.getObservations()[0]);
+    });
+    return 1e9 / ns * envCount;
+}
+}  // namespace
+
+/**
+ * @brief Prints game steps per second for 1 up to all hardware threads
+ */
+int main()
+{
+    const int envCount = 4096;
+    const long steps = 500;
+    int maxThreads = std::max((int) std::thread::hardware_concurrency(), 1);
+
+    std::printf("%8s %18s\n", "threads", "game steps/s");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::printf("%8d %18.0f\n", threads, measureBatch(envCount, threads, steps));
+    }
+    return 0;
+}
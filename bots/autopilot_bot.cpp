@@ -0,0 +1,116 @@
+/**
+ * @file autopilot_bot.cpp
+ * @brief Arena bot plugin that plays with the built-in Autopilot
+ *
+ * The Autopilot searches on a full SnakeSim, not on the observation of the C API. Every
+ * tick the bot reads the board, the snake from head to tail and its direction through the
+ * C API and restores them into its own SnakeSim, which is never stepped. The bot does not
+ * know the seed of the game, so it cannot tell where food will spawn next.
+ */
+
+#include <vector>
+
+#include "../include/autopilot.h"
+#include "../include/evilsnake_bot.h"
+#include "../include/game_config.h"
+#include "../include/snake_sim.h"
+
+struct EvilSnakeBot {
+    SnakeSim sim;
+    Autopilot autopilot;
+    std::vector<uint8_t> observation;
+    std::vector<int32_t> snakeCells;
+    std::vector<Position> body;
+    std::vector<Position> walls;
+
+    EvilSnakeBot(const GameConfig &config)
+        : sim(config, 0),
+          autopilot(sim.getGrid()),
+          observation(sim.getGrid().getCellCount()),
+          snakeCells(sim.getGrid().getCellCount())
+    {
+        body.reserve(sim.getGrid().getCellCount());
+        walls.reserve(sim.getGrid().getCellCount());
+    }
+};
+
+namespace
+{
+/**
+ * @brief Restores the state of the game into the bot's SnakeSim
+ *
+ * @return true if the game could be read and has food on the board
+ */
+bool readGame(EvilSnakeBot &bot, const EvilSnake *game)
+{
+    if (evilsnake_observe(game, bot.observation.data(), bot.observation.size()) < 0) return false;
+    int length = evilsnake_get_snake(game, bot.snakeCells.data(), bot.snakeCells.size());
+    if (length <= 0) return false;
+
+    const Grid &grid = bot.sim.getGrid();
+    int food = -1;
+    bot.walls.clear();
+    for (int cell = 0; cell < grid.getCellCount(); cell++) {
+        if (bot.observation[cell] == EVILSNAKE_CELL_FOOD) food = cell;
+        if (bot.observation[cell] == EVILSNAKE_CELL_WALL) bot.walls.push_back(grid.getCellPosition(cell));
+    }
+    if (food < 0) return false;
+
+    bot.body.clear();
+    for (int i = 0; i < length; i++) {
+        bot.body.push_back(grid.getCellPosition(bot.snakeCells[i]));
+    }
+    bot.sim.restore(bot.body, (Direction) evilsnake_get_direction(game), grid.getCellPosition(food), bot.walls);
+    return true;
+}
+}  // namespace
+
+/**
+ * @brief Gets the plugin ABI version the bot was built with
+ */
+uint32_t evilsnake_bot_abi_version(void) { return EVILSNAKE_BOT_ABI_VERSION; }
+
+/**
+ * @brief Gets the name of the bot in the ranking
+ */
+const char *evilsnake_bot_name(void) { return "autopilot"; }
+
+/**
+ * @brief Creates the bot and its buffers for the board
+ *
+ * @return EvilSnakeBot* Bot for the game, NULL without a config or if memory ran out
+ *
+ * All buffers are sized for the whole board here, so choosing a move never allocates.
+ * No exception of the game's constructors crosses the plugin ABI.
+ */
+EvilSnakeBot *evilsnake_bot_create(const EvilSnakeConfig *config)
+{
+    if (config == nullptr) return nullptr;
+
+    GameConfig gameConfig;
+    gameConfig.cellAmountX = config->board_width;
+    gameConfig.cellAmountY = config->board_height;
+    gameConfig.wallAmount = config->wall_amount;
+    try {
+        return new EvilSnakeBot(gameConfig);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Chooses the move of the next tick from the current state of the game
+ *
+ * @return int32_t Direction of the Autopilot, EVILSNAKE_DIRECTION_NONE if the game cannot be read
+ */
+int32_t evilsnake_bot_choose(EvilSnakeBot *bot, const EvilSnake *game)
+{
+    if (!readGame(*bot, game)) return EVILSNAKE_DIRECTION_NONE;
+
+    return (int32_t) bot->autopilot.chooseDirection(bot->sim);
+}
+
+/**
+ * @brief Destroys the bot at the end of a game
+ */
+void evilsnake_bot_destroy(EvilSnakeBot *bot) { delete bot; }
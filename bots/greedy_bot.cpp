@@ -0,0 +1,111 @@
+/**
+ * @file greedy_bot.cpp
+ * @brief Arena bot plugin that heads straight for the food
+ *
+ * Uses only the libevilsnake C API: every tick it reads the observation of the game and
+ * takes the free neighboring cell closest to the food, or any free cell if none is
+ * closer. It never plans ahead, so it serves as the baseline of the arena ranking.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "../include/evilsnake_bot.h"
+
+struct EvilSnakeBot {
+    std::vector<uint8_t> observation;
+};
+
+namespace
+{
+/**
+ * @brief All directions the snake can move in
+ */
+constexpr int32_t DIRECTIONS[] = {EVILSNAKE_DIRECTION_UP, EVILSNAKE_DIRECTION_DOWN, EVILSNAKE_DIRECTION_LEFT,
+    EVILSNAKE_DIRECTION_RIGHT};
+
+/**
+ * @brief Gets the shorter distance between two coordinates on a wrapping axis
+ */
+int getWrappedDistance(int from, int to, int size)
+{
+    int distance = std::abs(from - to);
+    return distance < size - distance ? distance : size - distance;
+}
+}  // namespace
+
+/**
+ * @brief Gets the plugin ABI version the bot was built with
+ */
+uint32_t evilsnake_bot_abi_version(void) { return EVILSNAKE_BOT_ABI_VERSION; }
+
+/**
+ * @brief Gets the name of the bot in the ranking
+ */
+const char *evilsnake_bot_name(void) { return "greedy"; }
+
+/**
+ * @brief Creates the bot for one game
+ *
+ * @return EvilSnakeBot* Bot with an observation buffer for the board, NULL without a config or if memory ran out
+ *
+ * No exception of the buffer allocation crosses the plugin ABI.
+ */
+EvilSnakeBot *evilsnake_bot_create(const EvilSnakeConfig *config)
+{
+    if (config == nullptr) return nullptr;
+
+    EvilSnakeBot *bot = new (std::nothrow) EvilSnakeBot;
+    if (bot == nullptr) return nullptr;
+
+    try {
+        bot->observation.resize((size_t) config->board_width * config->board_height);
+    } catch (...) {
+        delete bot;
+        return nullptr;
+    }
+    return bot;
+}
+
+/**
+ * @brief Chooses the move of the next tick
+ *
+ * @return int32_t Direction towards the food, EVILSNAKE_DIRECTION_NONE to keep going if every move collides
+ */
+int32_t evilsnake_bot_choose(EvilSnakeBot *bot, const EvilSnake *game)
+{
+    int width = evilsnake_get_width(game);
+    int height = evilsnake_get_height(game);
+    if (evilsnake_observe(game, bot->observation.data(), bot->observation.size()) < 0) {
+        return EVILSNAKE_DIRECTION_NONE;
+    }
+
+    int head = 0;
+    int food = 0;
+    for (int cell = 0; cell < width * height; cell++) {
+        if (bot->observation[cell] == EVILSNAKE_CELL_SNAKE_HEAD) head = cell;
+        if (bot->observation[cell] == EVILSNAKE_CELL_FOOD) food = cell;
+    }
+
+    int32_t best = EVILSNAKE_DIRECTION_NONE;
+    int bestDistance = width + height;
+    for (int32_t dir : DIRECTIONS) {
+        int x = (head % width + (dir == EVILSNAKE_DIRECTION_RIGHT) - (dir == EVILSNAKE_DIRECTION_LEFT) + width) % width;
+        int y = (head / width + (dir == EVILSNAKE_DIRECTION_DOWN) - (dir == EVILSNAKE_DIRECTION_UP) + height) % height;
+        uint8_t cell = bot->observation[y * width + x];
+        if (cell != EVILSNAKE_CELL_EMPTY && cell != EVILSNAKE_CELL_FOOD) continue;
+
+        int distance = getWrappedDistance(x, food % width, width) + getWrappedDistance(y, food / width, height);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = dir;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Destroys the bot at the end of a game
+ */
+void evilsnake_bot_destroy(EvilSnakeBot *bot) { delete bot; }
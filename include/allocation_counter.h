@@ -0,0 +1,12 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace AllocationCounter
+{
+bool isEnabled();
+uint64_t getCount();
+}  // namespace AllocationCounter
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "direction.h"
+#include "grid.h"
+#include "position.h"
+#include "snake_sim.h"
+
+class Autopilot
+{
+   private:
+    Grid grid;
+    std::chrono::microseconds budget;
+    std::chrono::steady_clock::time_point deadline;
+    std::vector<int> cycleIndices;
+    std::vector<uint32_t> visitedStamps;
+    std::vector<uint32_t> blockedStamps;
+    std::vector<int> parents;
+    std::vector<int> distances;
+    std::vector<int> queue;
+    std::vector<int> path;
+    uint32_t visitedStamp;
+    uint32_t blockedStamp;
+    bool timedOut;
+
+    int getNeighbor(int cell, Direction dir) const;
+    Direction getDirectionTo(int from, int to) const;
+    int getCycleDistance(int from, int to) const;
+    bool isOpen(const SnakeSim &sim, int cell) const;
+    bool isInCycleOrder(const SnakeSim &sim) const;
+    bool isCycleSafe(const SnakeSim &sim, int cell) const;
+    void startVirtualBoard(const SnakeSim &sim);
+    bool search(int start, int target, bool virtualBoard, const SnakeSim &sim, Direction forbidden);
+    bool findPathToFood(const SnakeSim &sim);
+    bool isSafeAfterPath(const SnakeSim &sim);
+    Direction findCycleDirection(const SnakeSim &sim, bool pathFound) const;
+    Direction findTailChaseDirection(const SnakeSim &sim);
+    Direction findEscapeDirection(const SnakeSim &sim);
+
+   public:
+    Autopilot(const Grid &grid, std::chrono::microseconds budget = std::chrono::microseconds(2000));
+
+    Direction chooseDirection(const SnakeSim &sim);
+    Direction getCycleDirection(const Position &position) const;
+    bool hasTimedOut() const;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+#include <vector>
+
+class Bitboard
+{
+   private:
+    std::vector<uint64_t> words;
+
+   public:
+    Bitboard(int cellCount);
+
+    void clear();
+    void set(int cell);
+    void reset(int cell);
+    bool test(int cell) const;
+    int count() const;
+    const std::vector<uint64_t> &getWords() const;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef CELL_BATCH_H
+#define CELL_BATCH_H
+
+#include <vector>
+
+#include "raylib.h"
+
+class CellBatch
+{
+   private:
+    struct Quad {
+        Rectangle rectangle;
+        Color color;
+    };
+
+    std::vector<Quad> quads;
+
+   public:
+    CellBatch();
+
+    void reserve(int capacity);
+    void clear();
+    void add(Rectangle rectangle, Color color);
+    int submit() const;
+    int getCellCount() const;
+};
+
+#endif
@@ -1,12 +1,14 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
-#include <raylib.h>
-
 namespace Constants
 {
 constexpr int CELL_AMOUNT_Y = 15;
 constexpr int CELL_AMOUNT_X = 25;
+constexpr int MAX_CELL_AMOUNT = 4096;
+constexpr long MAX_VERIFIED_CELL_COUNT = 256 * 256;
+constexpr long MAX_VERIFIED_TICKS = 10000000;
+constexpr long VERIFIED_TICK_MARGIN = 16;
 
 constexpr float WINDOW_HEIGHT = 600;
 constexpr float CELL_SIZE = WINDOW_HEIGHT / CELL_AMOUNT_Y;
@@ -17,13 +19,23 @@ constexpr int WINNING_SCORE = 100;
 constexpr float DEFAULT_SNAKE_SPEED = 0.15f;
 constexpr float FAST_SNAKE_SPEED = 0.1f;
 
+constexpr int MAX_TICKS_PER_FRAME = 8;
+
 constexpr float EVENT_INTERVAL = 10.0f;
 constexpr int WALL_AMOUNT = 10;
 
-constexpr KeyboardKey KEY_PAUSE = KeyboardKey::KEY_J;
-constexpr KeyboardKey KEY_SCREENSHOT = KeyboardKey::KEY_L;
-constexpr KeyboardKey KEY_OPEN_SCREENSHOTS = KeyboardKey::KEY_O;
-constexpr KeyboardKey KEY_QUIT = KeyboardKey::KEY_SPACE;
+constexpr int PROFILER_FRAME_COUNT = 240;
+constexpr int CELL_BATCH_QUADS = 2048;
+
+constexpr int FONT_SIZE = 256;
+constexpr int SDF_FONT_SIZE = 64;
+constexpr int FONT_GLYPH_COUNT = 250;
+constexpr int FONT_GLYPH_PADDING = 4;
+
+constexpr float TEXT_SPACING = 2.0f;
+constexpr int TEXT_CACHE_CAPACITY = 256;
+
+constexpr int ALLOCATION_WARMUP_FRAMES = 60;
 }  // namespace Constants
 
 #endif
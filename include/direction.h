@@ -0,0 +1,6 @@
+#ifndef DIRECTION_H
+#define DIRECTION_H
+
+enum class Direction { NONE, UP, DOWN, LEFT, RIGHT };
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef EVILSNAKE_H
+#define EVILSNAKE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(EVILSNAKE_BUILDING_LIBRARY)
+#define EVILSNAKE_API __declspec(dllexport)
+#else
+#define EVILSNAKE_API __declspec(dllimport)
+#endif
+#else
+#define EVILSNAKE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EVILSNAKE_ABI_VERSION 1
+
+enum {
+    EVILSNAKE_DIRECTION_NONE = 0,
+    EVILSNAKE_DIRECTION_UP = 1,
+    EVILSNAKE_DIRECTION_DOWN = 2,
+    EVILSNAKE_DIRECTION_LEFT = 3,
+    EVILSNAKE_DIRECTION_RIGHT = 4,
+};
+
+enum {
+    EVILSNAKE_STATUS_RUNNING = 0,
+    EVILSNAKE_STATUS_GAME_OVER = 1,
+    EVILSNAKE_STATUS_FINISHED = 2,
+    EVILSNAKE_STATUS_ERROR = -1,
+};
+
+enum {
+    EVILSNAKE_CELL_EMPTY = 0,
+    EVILSNAKE_CELL_SNAKE_BODY = 1,
+    EVILSNAKE_CELL_SNAKE_HEAD = 2,
+    EVILSNAKE_CELL_FOOD = 3,
+    EVILSNAKE_CELL_WALL = 4,
+};
+
+typedef struct EvilSnakeConfig {
+    int32_t board_width;
+    int32_t board_height;
+    int32_t winning_score;
+    int32_t wall_amount;
+    float default_speed;
+    float fast_speed;
+    float event_interval;
+} EvilSnakeConfig;
+
+typedef struct EvilSnakeStepResult {
+    uint8_t ate_food;
+    uint8_t collided;
+    uint8_t mode_changed;
+    uint8_t finished;
+    int32_t status;
+    int32_t score;
+    int32_t mode;
+    int64_t ticks;
+    float elapsed_time;
+} EvilSnakeStepResult;
+
+typedef struct EvilSnake EvilSnake;
+
+EVILSNAKE_API uint32_t evilsnake_abi_version(void);
+EVILSNAKE_API void evilsnake_default_config(EvilSnakeConfig *config);
+
+EVILSNAKE_API EvilSnake *evilsnake_create(const EvilSnakeConfig *config, uint64_t seed);
+EVILSNAKE_API void evilsnake_destroy(EvilSnake *game);
+EVILSNAKE_API void evilsnake_reset(EvilSnake *game, uint64_t seed);
+EVILSNAKE_API int32_t evilsnake_step(EvilSnake *game, int32_t direction, EvilSnakeStepResult *result);
+
+EVILSNAKE_API size_t evilsnake_observation_size(const EvilSnake *game);
+EVILSNAKE_API int32_t evilsnake_observe(const EvilSnake *game, uint8_t *buffer, size_t size);
+
+EVILSNAKE_API uint64_t evilsnake_get_seed(const EvilSnake *game);
+EVILSNAKE_API int32_t evilsnake_get_width(const EvilSnake *game);
+EVILSNAKE_API int32_t evilsnake_get_height(const EvilSnake *game);
+EVILSNAKE_API int32_t evilsnake_get_status(const EvilSnake *game);
+EVILSNAKE_API int32_t evilsnake_get_score(const EvilSnake *game);
+EVILSNAKE_API int64_t evilsnake_get_ticks(const EvilSnake *game);
+EVILSNAKE_API int32_t evilsnake_get_direction(const EvilSnake *game);
+EVILSNAKE_API int32_t evilsnake_get_snake(const EvilSnake *game, int32_t *cells, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
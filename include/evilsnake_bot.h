@@ -0,0 +1,38 @@
+#ifndef EVILSNAKE_BOT_H
+#define EVILSNAKE_BOT_H
+
+#include <stdint.h>
+
+#include "evilsnake.h"
+
+#if defined(_WIN32)
+#define EVILSNAKE_BOT_EXPORT __declspec(dllexport)
+#else
+#define EVILSNAKE_BOT_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EVILSNAKE_BOT_ABI_VERSION 2
+
+typedef struct EvilSnakeBot EvilSnakeBot;
+
+typedef uint32_t (*EvilSnakeBotAbiVersionFunction)(void);
+typedef const char *(*EvilSnakeBotNameFunction)(void);
+typedef EvilSnakeBot *(*EvilSnakeBotCreateFunction)(const EvilSnakeConfig *config);
+typedef int32_t (*EvilSnakeBotChooseFunction)(EvilSnakeBot *bot, const EvilSnake *game);
+typedef void (*EvilSnakeBotDestroyFunction)(EvilSnakeBot *bot);
+
+EVILSNAKE_BOT_EXPORT uint32_t evilsnake_bot_abi_version(void);
+EVILSNAKE_BOT_EXPORT const char *evilsnake_bot_name(void);
+EVILSNAKE_BOT_EXPORT EvilSnakeBot *evilsnake_bot_create(const EvilSnakeConfig *config);
+EVILSNAKE_BOT_EXPORT int32_t evilsnake_bot_choose(EvilSnakeBot *bot, const EvilSnake *game);
+EVILSNAKE_BOT_EXPORT void evilsnake_bot_destroy(EvilSnakeBot *bot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef FONT_ATLAS_CACHE_H
+#define FONT_ATLAS_CACHE_H
+
+#include <string>
+
+#include "raylib.h"
+
+namespace FontAtlasCache
+{
+bool load(const std::string &cachePath, const std::string &sourcePath, int fontSize, int glyphCount, bool sdf,
+    Font &font);
+bool save(const std::string &cachePath, const std::string &sourcePath, const Font &font, const Image &atlas, bool sdf);
+}  // namespace FontAtlasCache
+
+#endif
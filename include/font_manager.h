@@ -1,6 +1,7 @@
 #ifndef FONT_MANAGER_H
 #define FONT_MANAGER_H
 
+#include <string>
 #include <unordered_map>
 
 #include "raylib.h"
@@ -8,22 +9,26 @@
 class FontManager
 {
    public:
-    static FontManager &getInstance();
+    FontManager();
+    ~FontManager();
+
+    FontManager(const FontManager &) = delete;
+    FontManager &operator=(const FontManager &) = delete;
 
-    void initFonts();
+    void initFonts(const std::string &cacheDirectory = "", bool sdf = false);
     Font getFont(int fontId) const;
+    bool isSdf() const;
+    Shader getSdfShader() const;
 
     static const int FONT_MAIN;
     static const int FONT_TITLE;
 
    private:
-    FontManager();
-    ~FontManager();
-
-    FontManager(const FontManager &) = delete;
-    FontManager &operator=(const FontManager &) = delete;
-
     std::unordered_map<int, Font> fonts;
+    bool sdf;
+    Shader sdfShader;
+
+    bool loadFont(int fontId, const char *name, const std::string &cacheDirectory);
 };
 
 #endif
@@ -0,0 +1,79 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+enum class ProfilerPhase {
+    FRAME,
+    TICK,
+    HANDLE_INPUT,
+    UPDATE,
+    DRAW_GRID,
+    DRAW_GAME_OBJECTS,
+    DRAW_UI,
+    COUNT,
+};
+
+struct PhaseStats {
+    float p50 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+
+class FrameProfiler
+{
+   public:
+    static constexpr int PHASE_COUNT = (int) ProfilerPhase::COUNT;
+
+   private:
+    struct FrameSample {
+        float milliseconds[PHASE_COUNT] = {};
+        int drawCalls = 0;
+    };
+
+    std::vector<FrameSample> frames;
+    std::atomic<uint64_t> publishedFrames;
+    FrameSample current;
+    std::chrono::steady_clock::time_point frameStart;
+    bool frameStarted;
+    mutable std::vector<float> sortBuffer;
+
+    PhaseStats getSortedStats(int count) const;
+
+   public:
+    FrameProfiler();
+
+    FrameProfiler(const FrameProfiler &) = delete;
+    FrameProfiler &operator=(const FrameProfiler &) = delete;
+
+    void beginFrame();
+    void add(ProfilerPhase phase, std::chrono::steady_clock::duration elapsed);
+    void addDrawCalls(int count);
+
+    int getFrameCount() const;
+    float getMilliseconds(ProfilerPhase phase, int age) const;
+    PhaseStats getStats(ProfilerPhase phase) const;
+    int getDrawCalls(int age) const;
+    PhaseStats getDrawCallStats() const;
+    static const char *getPhaseName(ProfilerPhase phase);
+};
+
+class ScopedTimer
+{
+   private:
+    FrameProfiler &profiler;
+    ProfilerPhase phase;
+    std::chrono::steady_clock::time_point start;
+
+   public:
+    ScopedTimer(FrameProfiler &profiler, ProfilerPhase phase);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+};
+
+#endif
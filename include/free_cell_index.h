@@ -0,0 +1,26 @@
+#ifndef FREE_CELL_INDEX_H
+#define FREE_CELL_INDEX_H
+
+#include <vector>
+
+#include "random.h"
+
+class FreeCellIndex
+{
+   private:
+    std::vector<int> freeCells;
+    std::vector<int> slots;
+
+   public:
+    FreeCellIndex(int cellCount);
+
+    void reset();
+    void occupy(int cell);
+    void release(int cell);
+    bool isFree(int cell) const;
+    int getFreeCount() const;
+    int getCellCount() const;
+    int getRandomFreeCell(Random &rng) const;
+};
+
+#endif
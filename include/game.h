@@ -1,38 +1,90 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "game_mode.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "autopilot.h"
+#include "cell_batch.h"
+#include "direction.h"
+#include "frame_profiler.h"
+#include "game_config.h"
 #include "game_state.h"
 #include "raylib.h"
-#include "snake.h"
+#include "replay.h"
+#include "screen_manager.h"
+#include "snake_sim.h"
+#include "static_layer.h"
+#include "sound_manager.h"
 
 class Game
 {
    private:
+    ScreenManager &screens;
+    SoundManager &sounds;
     GameState state;
-    GameMode mode;
-    Snake snake;
-    Vector2 foodPosition;
-    std::vector<Vector2> wallPositions;
-    int score;
+    SnakeSim sim;
+    Autopilot autopilot;
+    bool autopilotEnabled;
+    std::optional<uint64_t> fixedSeed;
+    Direction pendingDirection;
+    int viewCellAmountX;
+    int viewCellAmountY;
+    float cameraX;
+    float cameraY;
     float startTime;
     float endTime;
-    float timeSinceLastMove;
-    float timeSinceLastEventCheck;
+    float tickAccumulator;
+    std::string recordDirectory;
+    ReplayWriter recorder;
+    std::optional<Replay> replay;
+    ReplayPlayer replayPlayer;
+    FrameProfiler profiler;
+    bool profilerVisible;
+    StaticLayer gridLayer;
+    StaticLayer wallLayer;
+    CellBatch cellBatch;
+    StaticLayer boardLayer;
+    std::vector<Position> dirtyCells;
+    std::string modeText;
+    std::string timeText;
+    uint64_t frameAllocationCount;
+    GameState allocationCheckState;
+    int allocationCheckFrames;
 
     void update();
+    void tick();
     void reset();
-    void changeGameMode();
     void handleInput();
     void handleDirectionChange(Direction dir);
+    void toggleAutopilot();
+    void startGame();
+    void checkFrameAllocations();
 
-    void draw();
+    float getInterpolation() const;
+    Vector2 getInterpolatedPosition(const Position &previous, const Position &current, float alpha) const;
+    void updateCamera(float alpha);
+    void drawCell(Vector2 cell, Color color);
+    void drawCell(const Position &position, Color color);
+
+    void markChangedCells();
+    Color getCellColor(const Position &position) const;
+    void updateStaticLayers();
     void drawGrid();
+    void drawBoardLayer(const StaticLayer &layer);
+    void drawSnake(float alpha);
     void drawGameObjects();
     void drawUI();
 
    public:
-    Game();
+    Game(ScreenManager &screens, SoundManager &sounds, const GameConfig &config = GameConfig{},
+        std::optional<uint64_t> seed = std::nullopt, const std::string &recordDirectory = "");
+    void startReplay(const Replay &replay);
+    void processFrame();
+    void draw();
+    void finish();
     void run();
 };
 
@@ -0,0 +1,42 @@
+#ifndef GAME_CONFIG_H
+#define GAME_CONFIG_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "constants.h"
+
+struct GameConfig {
+    int cellAmountX = Constants::CELL_AMOUNT_X;
+    int cellAmountY = Constants::CELL_AMOUNT_Y;
+    int viewCellAmountX = Constants::CELL_AMOUNT_X;
+    int viewCellAmountY = Constants::CELL_AMOUNT_Y;
+    float cellSize = Constants::CELL_SIZE;
+    int winningScore = Constants::WINNING_SCORE;
+    float defaultSnakeSpeed = Constants::DEFAULT_SNAKE_SPEED;
+    float fastSnakeSpeed = Constants::FAST_SNAKE_SPEED;
+    float eventInterval = Constants::EVENT_INTERVAL;
+    int wallAmount = Constants::WALL_AMOUNT;
+    bool incrementalRendering = false;
+    bool sdfFonts = false;
+};
+
+struct LaunchOptions {
+    GameConfig config;
+    std::optional<uint64_t> seed;
+    std::string recordDirectory;
+    std::string replayPath;
+    std::string tracePath;
+};
+
+namespace ConfigLoader
+{
+bool setValue(GameConfig &config, const std::string &key, const std::string &value);
+bool loadFromFile(GameConfig &config, const std::string &path);
+bool loadFromArguments(LaunchOptions &options, int argc, char **argv);
+bool validate(const GameConfig &config);
+void printUsage(const char *program);
+}  // namespace ConfigLoader
+
+#endif
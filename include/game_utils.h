@@ -1,6 +1,7 @@
 #ifndef GAMEUTILS_H
 #define GAMEUTILS_H
 
+#include <cstdint>
 #include <string>
 
 #include "game_mode.h"
@@ -11,12 +12,11 @@ namespace GameUtils
 void applyApplicationIcon();
 void takeScreenshot();
 void openScreenshotsFolder();
-Vector2 getRandomGridPosition();
-Vector2 getRandomFoodPosition(const std::vector<Vector2> &snakePosition, const std::vector<Vector2> &wallPositions);
-Vector2 getRandomWallPosition(const std::vector<Vector2> &snakePosition, const Vector2 &foodPosition);
-std::string getFormattedGameTime(float startTime, float until);
-std::string getFormattedGameMode(GameMode mode);
+std::string getReplayFilePath(const std::string &directory, uint64_t seed);
+void formatGameTime(float startTime, float until, std::string &text);
+const char *getFormattedGameMode(GameMode mode);
 std::string getAssetPath();
+std::string getCachePath();
 }  // namespace GameUtils
 
 #endif
@@ -0,0 +1,23 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include "position.h"
+
+class Grid
+{
+   private:
+    int width;
+    int height;
+
+   public:
+    Grid(int width, int height);
+
+    int getWidth() const;
+    int getHeight() const;
+    int getCellCount() const;
+    int getCellIndex(const Position &position) const;
+    Position getCellPosition(int cell) const;
+    Position wrap(int x, int y) const;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef KEY_BINDINGS_H
+#define KEY_BINDINGS_H
+
+#include <raylib.h>
+
+#include "direction.h"
+
+namespace Constants
+{
+constexpr KeyboardKey KEY_PAUSE = KeyboardKey::KEY_J;
+constexpr KeyboardKey KEY_SCREENSHOT = KeyboardKey::KEY_L;
+constexpr KeyboardKey KEY_OPEN_SCREENSHOTS = KeyboardKey::KEY_O;
+constexpr KeyboardKey KEY_PROFILER = KeyboardKey::KEY_F3;
+constexpr KeyboardKey KEY_AUTOPILOT = KeyboardKey::KEY_P;
+constexpr KeyboardKey KEY_QUIT = KeyboardKey::KEY_SPACE;
+
+struct DirectionKey {
+    KeyboardKey key;
+    Direction direction;
+};
+
+constexpr DirectionKey DIRECTION_KEYS[] = {
+    {KeyboardKey::KEY_UP, Direction::UP},
+    {KeyboardKey::KEY_W, Direction::UP},
+    {KeyboardKey::KEY_DOWN, Direction::DOWN},
+    {KeyboardKey::KEY_S, Direction::DOWN},
+    {KeyboardKey::KEY_LEFT, Direction::LEFT},
+    {KeyboardKey::KEY_A, Direction::LEFT},
+    {KeyboardKey::KEY_RIGHT, Direction::RIGHT},
+    {KeyboardKey::KEY_D, Direction::RIGHT},
+};
+}  // namespace Constants
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef MCTS_BOT_H
+#define MCTS_BOT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "direction.h"
+#include "random.h"
+#include "snake_sim.h"
+#include "thread_pool.h"
+
+class MctsBot
+{
+   private:
+    struct Node {
+        int children[4];
+        int visits;
+        float reward;
+    };
+
+    struct alignas(64) Worker {
+        SnakeSim scratch;
+        Random rng = Random(0);
+        std::vector<Node> nodes;
+        std::vector<int> path;
+        long playouts;
+    };
+
+    struct alignas(64) RootStats {
+        std::atomic<long> visits;
+        std::atomic<double> reward;
+    };
+
+    ThreadPool pool;
+    std::vector<Worker> workers;
+    RootStats rootStats[4];
+    long playoutCount;
+
+    void search(Worker &worker, const SnakeSim &sim, std::chrono::steady_clock::time_point deadline);
+    void runPlayout(Worker &worker, const SnakeSim &sim);
+    int addNode(Worker &worker);
+    Direction selectChild(const Worker &worker, int node, Direction forbidden) const;
+    void rollout(Worker &worker);
+
+   public:
+    MctsBot(int threadCount = (int) std::thread::hardware_concurrency(), uint64_t seed = Random::generateSeed());
+
+    MctsBot(const MctsBot &) = delete;
+    MctsBot &operator=(const MctsBot &) = delete;
+
+    Direction chooseDirection(const SnakeSim &sim);
+    Direction chooseDirection(const SnakeSim &sim, std::chrono::microseconds budget);
+    long getPlayoutCount() const;
+    int getThreadCount() const;
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include <cstdint>
+
+struct Position {
+    int16_t x;
+    int16_t y;
+
+    bool operator==(const Position &other) const = default;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+class Random
+{
+   private:
+    uint64_t seed;
+    uint64_t state[4];
+
+   public:
+    Random(uint64_t seed);
+
+    static uint64_t generateSeed();
+
+    void reseed(uint64_t seed);
+    uint64_t getSeed() const;
+    uint64_t next();
+    int nextInt(int min, int max);
+};
+
+#endif
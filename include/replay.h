@@ -0,0 +1,79 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "direction.h"
+#include "game_config.h"
+#include "snake_sim.h"
+
+struct ReplayRun {
+    Direction direction;
+    uint32_t length;
+};
+
+struct ReplayOutcome {
+    long ticks = 0;
+    int score = 0;
+    float elapsedTime = 0.0f;
+    SimStatus status = SimStatus::RUNNING;
+
+    bool operator==(const ReplayOutcome &other) const = default;
+};
+
+struct Replay {
+    uint64_t seed = 0;
+    GameConfig config;
+    std::vector<ReplayRun> runs;
+    ReplayOutcome outcome;
+};
+
+class ReplayWriter
+{
+   private:
+    std::ofstream file;
+    std::vector<uint8_t> buffer;
+    Direction runDirection;
+    uint32_t runLength;
+
+    void flushRun();
+    void flushBuffer();
+
+   public:
+    ReplayWriter();
+    ~ReplayWriter();
+
+    bool open(const std::string &path, uint64_t seed, const GameConfig &config);
+    void record(Direction dir);
+    void finish(const SnakeSim &sim);
+    bool isOpen() const;
+};
+
+class ReplayPlayer
+{
+   private:
+    const std::vector<ReplayRun> *runs;
+    size_t runIndex;
+    uint32_t runPosition;
+
+   public:
+    ReplayPlayer();
+    ReplayPlayer(const Replay &replay);
+
+    Direction next();
+    bool isFinished() const;
+};
+
+namespace ReplayUtils
+{
+bool load(const std::string &path, Replay &replay);
+bool decode(const std::vector<uint8_t> &data, Replay &replay);
+std::vector<uint8_t> encode(const Replay &replay);
+ReplayOutcome simulate(const Replay &replay, long maxTicks);
+ReplayOutcome getOutcome(const SnakeSim &sim);
+}  // namespace ReplayUtils
+
+#endif
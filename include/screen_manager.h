@@ -1,25 +1,62 @@
 #ifndef SCREENMANAGER_H
 #define SCREENMANAGER_H
 
+#include <cstdint>
 #include <string>
 
+#include "font_manager.h"
+#include "frame_profiler.h"
+#include "raylib.h"
+#include "static_layer.h"
+#include "text_cache.h"
+#include "text_utils.h"
+
 class ScreenManager
 {
    public:
-    static ScreenManager &getInstance();
+    ScreenManager(const FontManager &fonts, Rectangle bounds);
+
+    Rectangle getBounds() const;
+    void setBounds(Rectangle bounds);
 
-    void drawMenuScreen();
-    void drawPlayingScreen(int score, std::string gameMode, std::string time);
-    void drawPauseScreen(int score, std::string time);
-    void drawGameOverScreen(int score, std::string time);
-    void drawFinishedScreen(int score, std::string time);
+    void prepareMenuScreen(int winningScore);
+    void drawMenuScreen(int winningScore);
+    void drawPlayingScreen(int score, int winningScore, const std::string &gameMode, const std::string &time);
+    void drawPauseScreen(int score, int winningScore, const std::string &time);
+    void drawGameOverScreen(int score, int winningScore, const std::string &time);
+    void drawFinishedScreen(int score, int winningScore, const std::string &time);
+    void drawSeedInfo(uint64_t seed);
+    void drawProfilerOverlay(const FrameProfiler &profiler);
 
    private:
-    ScreenManager();
-    ~ScreenManager();
+    struct RetainedLabel {
+        std::string value;
+        std::string text;
+        bool valid = false;
+    };
+
+    const FontManager &fonts;
+    Rectangle bounds;
+    TextCache textCache;
+    StaticLayer menuLayer;
+    int menuWinningScore;
+    int shownScore;
+    int shownWinningScore;
+    uint64_t shownSeed;
+    std::string scoreText;
+    std::string seedText;
+    RetainedLabel modeLabel;
+    RetainedLabel timeLabel;
 
-    ScreenManager(const ScreenManager &) = delete;
-    ScreenManager &operator=(const ScreenManager &) = delete;
+    void drawText(const char *text, int fontId, float fontSize, VerticalAlignment verticalAlignment,
+        HorizontalAlignment horizontalAlignment, float padding);
+    void drawText(Rectangle area, const char *text, int fontId, float fontSize, VerticalAlignment verticalAlignment,
+        HorizontalAlignment horizontalAlignment, float padding);
+    void beginText() const;
+    void endText() const;
+    void drawMenuLabels(Rectangle area, int winningScore);
+    const char *getScoreText(int score, int winningScore);
+    const char *getLabelText(RetainedLabel &label, const char *prefix, const std::string &value);
 };
 
 #endif
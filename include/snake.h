@@ -3,28 +3,36 @@
 
 #include <vector>
 
-#include "raylib.h"
-
-enum class Direction { NONE, UP, DOWN, LEFT, RIGHT };
+#include "bitboard.h"
+#include "direction.h"
+#include "grid.h"
+#include "position.h"
+#include "snake_body.h"
 
 class Snake
 {
    private:
+    Grid grid;
     Direction direction;
+    bool collided;
+    bool grew;
+    Position previousTail;
 
-    bool hasEaten(const Vector2 &foodPosition) const;
+    bool hasEaten(const Position &head, const Position &foodPosition) const;
 
    public:
-    Snake(const Vector2 &position);
+    Snake(const Position &position, const Grid &grid);
 
     float speed;
-    std::vector<Vector2> body;
+    SnakeBody body;
 
     void setDirection(Direction dir);
-    bool moveAndCheckForFood(const Vector2 &foodPosition);
-    bool hasCollided(const std::vector<Vector2> &foodPosition) const;
-    void draw() const;
-    void resetToPosition(const Vector2 &position);
+    Direction getDirection() const;
+    bool moveAndCheckForFood(const Position &foodPosition, Bitboard &occupancy);
+    bool hasCollided() const;
+    Position getPreviousPosition(int index) const;
+    void resetToPosition(const Position &position);
+    void resetToBody(const std::vector<Position> &positions, Direction dir);
 };
 
 #endif
@@ -0,0 +1,29 @@
+#ifndef SNAKE_BODY_H
+#define SNAKE_BODY_H
+
+#include <vector>
+
+#include "position.h"
+
+class SnakeBody
+{
+   private:
+    std::vector<Position> segments;
+    int headIndex;
+    int length;
+
+   public:
+    SnakeBody(int capacity);
+
+    void assign(const Position &position);
+    void pushFront(const Position &position);
+    void popBack();
+
+    const Position &front() const;
+    const Position &back() const;
+    const Position &operator[](int index) const;
+    int size() const;
+    int capacity() const;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef SNAKE_SIM_H
+#define SNAKE_SIM_H
+
+#include <vector>
+
+#include "bitboard.h"
+#include "direction.h"
+#include "free_cell_index.h"
+#include "game_config.h"
+#include "game_mode.h"
+#include "grid.h"
+#include "position.h"
+#include "random.h"
+#include "snake.h"
+
+enum class SimStatus {
+    RUNNING,
+    GAME_OVER,
+    FINISHED,
+};
+
+struct StepResult {
+    bool ateFood = false;
+    bool collided = false;
+    bool modeChanged = false;
+    bool finished = false;
+};
+
+class SnakeSim
+{
+   private:
+    GameConfig config;
+    Grid grid;
+    Random rng;
+    SimStatus status;
+    GameMode mode;
+    Snake snake;
+    Position foodPosition;
+    std::vector<Position> wallPositions;
+    FreeCellIndex freeCells;
+    Bitboard occupancy;
+    int score;
+    long ticks;
+    float elapsedTime;
+    float timeSinceLastEventCheck;
+
+    bool changeGameMode();
+    bool spawnFood();
+
+   public:
+    SnakeSim(const GameConfig &config = GameConfig{}, uint64_t seed = Random::generateSeed());
+
+    void reset();
+    void reset(uint64_t seed);
+    void reseed(uint64_t seed);
+    void restore(const std::vector<Position> &body, Direction dir, const Position &food,
+        const std::vector<Position> &walls);
+    void setDirection(Direction dir);
+    StepResult step(Direction dir = Direction::NONE);
+
+    const GameConfig &getConfig() const;
+    const Grid &getGrid() const;
+    uint64_t getSeed() const;
+    SimStatus getStatus() const;
+    GameMode getMode() const;
+    const Snake &getSnake() const;
+    const Position &getFoodPosition() const;
+    const std::vector<Position> &getWallPositions() const;
+    const Bitboard &getOccupancy() const;
+    bool isBlocked(const Position &position) const;
+    int getScore() const;
+    long getTicks() const;
+    float getElapsedTime() const;
+    float getTickDuration() const;
+};
+
+#endif
@@ -8,7 +8,11 @@
 class SoundManager
 {
    public:
-    static SoundManager &getInstance();
+    SoundManager();
+    ~SoundManager();
+
+    SoundManager(const SoundManager &) = delete;
+    SoundManager &operator=(const SoundManager &) = delete;
 
     void initSounds();
     void play(int soundId);
@@ -19,12 +23,6 @@ class SoundManager
     static const int SOUND_CAMERA;
 
    private:
-    SoundManager();
-    ~SoundManager();
-
-    SoundManager(const SoundManager &) = delete;
-    SoundManager &operator=(const SoundManager &) = delete;
-
     std::unordered_map<int, Sound> sounds;
 };
 
@@ -0,0 +1,17 @@
+#ifndef SPAWN_UTILS_H
+#define SPAWN_UTILS_H
+
+#include <optional>
+
+#include "free_cell_index.h"
+#include "grid.h"
+#include "position.h"
+#include "random.h"
+
+namespace SpawnUtils
+{
+Position getRandomGridPosition(Random &rng, const Grid &grid);
+std::optional<Position> getRandomFreePosition(Random &rng, const Grid &grid, const FreeCellIndex &freeCells);
+}  // namespace SpawnUtils
+
+#endif
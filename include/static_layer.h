@@ -0,0 +1,29 @@
+#ifndef STATIC_LAYER_H
+#define STATIC_LAYER_H
+
+#include "raylib.h"
+
+class StaticLayer
+{
+   private:
+    RenderTexture2D target;
+    bool loaded;
+    bool valid;
+
+   public:
+    StaticLayer();
+    ~StaticLayer();
+
+    StaticLayer(const StaticLayer &) = delete;
+    StaticLayer &operator=(const StaticLayer &) = delete;
+
+    bool needsRedraw(int width, int height) const;
+    void beginRedraw(int width, int height);
+    void endRedraw();
+    void beginUpdate();
+    void endUpdate();
+    void invalidate();
+    void draw(Rectangle source, Rectangle destination) const;
+};
+
+#endif
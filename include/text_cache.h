@@ -0,0 +1,31 @@
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+
+class TextCache
+{
+   private:
+    struct Entry {
+        uint64_t hash;
+        std::string text;
+        unsigned int fontTexture;
+        float fontSize;
+        Vector2 size;
+    };
+
+    std::vector<Entry> entries;
+
+   public:
+    TextCache();
+
+    Vector2 measure(const Font &font, const char *text, float fontSize);
+    void clear();
+    int getSize() const;
+};
+
+#endif
@@ -8,8 +8,10 @@ enum class HorizontalAlignment { LEFT, CENTER, RIGHT };
 
 namespace TextUtils
 {
-void drawAlignedText(const char *text, int fontId, float fontSize, Color color, VerticalAlignment verticalAlignment,
-    HorizontalAlignment horizontalAlignment, float padding);
+void drawAlignedText(const char *text, const Font &font, Rectangle bounds, float fontSize, Color color,
+    VerticalAlignment verticalAlignment, HorizontalAlignment horizontalAlignment, float padding);
+void drawMeasuredText(const char *text, const Font &font, Vector2 textSize, Rectangle bounds, float fontSize,
+    Color color, VerticalAlignment verticalAlignment, HorizontalAlignment horizontalAlignment, float padding);
 }  // namespace TextUtils
 
 #endif
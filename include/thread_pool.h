@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+   private:
+    struct alignas(64) WorkRange {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<WorkRange[]> ranges;
+    int workerCount;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    const std::function<void(size_t, int)> *job;
+    unsigned long generation;
+    int busyWorkers;
+    bool stopping;
+
+    void workerLoop(int worker);
+    void runWorker(int worker);
+    bool takeOwn(int worker, size_t &index);
+    bool steal(int worker);
+
+   public:
+    ThreadPool(int threadCount = (int) std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int getThreadCount() const;
+    void parallelFor(size_t count, const std::function<void(size_t index, int worker)> &fn);
+};
+
+#endif
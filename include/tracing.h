@@ -0,0 +1,55 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace Tracing
+{
+extern std::atomic<bool> enabled;
+
+bool start(const std::string &path);
+void stop();
+void record(const char *name, const char *category, std::chrono::steady_clock::time_point begin,
+    std::chrono::steady_clock::time_point end);
+
+/**
+ * @brief Checks whether a trace is being recorded, inline since every scope checks it
+ */
+inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+}  // namespace Tracing
+
+class TraceScope
+{
+   private:
+    const char *name;
+    const char *category;
+    std::chrono::steady_clock::time_point begin;
+    bool active;
+
+   public:
+    /**
+     * @brief Starts an event that lasts until the scope ends, name and category must be string literals
+     *
+     * Inline, so a scope without a running trace costs a single flag check.
+     */
+    TraceScope(const char *name, const char *category)
+        : name(name), category(category), begin(), active(Tracing::isEnabled())
+    {
+        if (active) begin = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Records the event if a trace was running when the scope started
+     */
+    ~TraceScope()
+    {
+        if (active) Tracing::record(name, category, begin, std::chrono::steady_clock::now());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef VEC_SNAKE_ENV_H
+#define VEC_SNAKE_ENV_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "direction.h"
+#include "game_config.h"
+#include "random.h"
+#include "snake_sim.h"
+#include "thread_pool.h"
+
+enum class ObservationCell : uint8_t {
+    EMPTY,
+    SNAKE_BODY,
+    SNAKE_HEAD,
+    FOOD,
+    WALL,
+};
+
+class VecSnakeEnv
+{
+   private:
+    GameConfig config;
+    int envCount;
+    int cellCount;
+    std::vector<SnakeSim> sims;
+    std::vector<Random> seedGenerators;
+    std::vector<uint8_t> observations;
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;
+    std::vector<int32_t> scores;
+    std::vector<int32_t> episodeTicks;
+    std::unique_ptr<ThreadPool> pool;
+
+    void stepRange(int begin, int end, const Direction *actions);
+    void resetEnv(int env);
+
+   public:
+    VecSnakeEnv(int envCount, const GameConfig &config = GameConfig{}, uint64_t seed = Random::generateSeed(),
+        int threadCount = 1);
+
+    void reset();
+    void step(const Direction *actions);
+
+    int getEnvCount() const;
+    int getCellCount() const;
+    const GameConfig &getConfig() const;
+    const SnakeSim &getSim(int env) const;
+    const uint8_t *getObservations() const;
+    const float *getRewards() const;
+    const uint8_t *getDones() const;
+    const int32_t *getScores() const;
+    const int32_t *getEpisodeTicks() const;
+
+    static void writeObservation(const SnakeSim &sim, uint8_t *out);
+};
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file allocation_counter.cpp
+ * @brief Global heap allocation counter for finding allocations in the frame loop
+ *
+ * Heap allocations in the frame loop cost time in the allocator at unpredictable
+ * moments, which shows up as frame time spikes. When the game is built with
+ * EVILSNAKE_COUNT_ALLOCATIONS, which CMake defines for debug builds, this file replaces
+ * the global operator new and delete to count every allocation, and the game logs each
+ * frame that allocates after it reached a steady state. Otherwise the counter is
+ * disabled and the default operators are used.
+ *
+ * Only allocations through operator new are counted, allocations of the C libraries
+ * below raylib are not.
+ */
+
+#include "../include/allocation_counter.h"
+
+#ifdef EVILSNAKE_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<uint64_t> allocationCount{0};
+
+/**
+ * @brief Counts and performs an allocation
+ *
+ * @param size Number of bytes, 0 allocates a unique pointer as operator new must
+ * @param alignment Required alignment, 0 for the default alignment of malloc
+ * @return void* The allocated memory, or nullptr if the allocation failed
+ */
+void *allocate(std::size_t size, std::size_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (alignment == 0) return std::malloc(size);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+/**
+ * @brief Counts and performs an allocation of operator new, throwing if it failed
+ *
+ * @param size Number of bytes
+ * @param alignment Required alignment, 0 for the default alignment of malloc
+ * @return void* The allocated memory
+ */
+void *allocateOrThrow(std::size_t size, std::size_t alignment)
+{
+    void *memory = allocate(size, alignment);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+}  // namespace
+
+/**
+ * @brief Replacements of the global operator new and delete, every allocation is counted
+ */
+void *operator new(std::size_t size) { return allocateOrThrow(size, 0); }
+void *operator new[](std::size_t size) { return allocateOrThrow(size, 0); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, (size_t) alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, (size_t) alignment); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, 0); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, 0); }
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete[](void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void *memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept { std::free(memory); }
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { std::free(memory); }
+
+/**
+ * @brief Checks whether allocations are counted in this build
+ *
+ * @return true, the game was built with EVILSNAKE_COUNT_ALLOCATIONS
+ */
+bool AllocationCounter::isEnabled() { return true; }
+
+/**
+ * @brief Gets the number of allocations since the program started
+ *
+ * @return uint64_t Number of calls of operator new on all threads
+ */
+uint64_t AllocationCounter::getCount() { return allocationCount.load(std::memory_order_relaxed); }
+
+#else
+
+/**
+ * @brief Checks whether allocations are counted in this build
+ *
+ * @return false, the game was built without EVILSNAKE_COUNT_ALLOCATIONS
+ */
+bool AllocationCounter::isEnabled() { return false; }
+
+/**
+ * @brief Gets the number of allocations since the program started
+ *
+ * @return uint64_t Always 0, allocations are not counted in this build
+ */
+uint64_t AllocationCounter::getCount() { return 0; }
+
+#endif
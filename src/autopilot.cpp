@@ -0,0 +1,483 @@
+/**
+ * @file autopilot.cpp
+ * @brief Implementation of the Autopilot class, a bot that steers the snake
+ *
+ * The autopilot is built around a Hamiltonian cycle, a closed route that visits every
+ * cell of the board exactly once. While the body is in cycle order, i.e. from the tail
+ * to the head every segment lies further along the cycle than the one before and the
+ * whole body spans less than one lap, the cells from the head onwards up to the tail
+ * are free. The tail can then always be reached by following the cycle, and a snake
+ * that only ever moves ahead on the cycle without passing its tail fills the whole
+ * board. In this state the autopilot takes the first step of the shortest path to the
+ * food, found by a breadth-first search on the occupancy grid, if that step moves ahead
+ * on the cycle without passing the tail or the food. Otherwise it takes the largest such
+ * shortcut, down to the plain cycle step. Every move brings the food closer along the
+ * cycle, so the snake cannot circle forever.
+ *
+ * Walls can block every move that keeps the order. Out of cycle order, the autopilot
+ * only takes the shortest path to the food if the snake could still reach its tail
+ * after eating at its end, else it chases its tail along the longest route and as a
+ * last resort moves to where it has the most room. It returns to the cycle rules as
+ * soon as the body is back in order.
+ *
+ * All searches stop at the per-tick time budget and fall back to the cheaper rules.
+ * All buffers are allocated once for the board. Stamp counters replace clearing the
+ * visited and blocked flags, so a search costs only the cells it actually visits.
+ */
+
+#include "../include/autopilot.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr Direction DIRECTIONS[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+
+/**
+ * @brief Number of visited cells between two checks of the time budget
+ */
+constexpr int CLOCK_CHECK_INTERVAL = 64;
+
+/**
+ * @brief Checks whether the time budget of the current tick is used up
+ */
+bool isPastDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    return std::chrono::steady_clock::now() > deadline;
+}
+
+/**
+ * @brief Gets the direction pointing the other way
+ */
+Direction getOpposite(Direction dir)
+{
+    switch (dir) {
+        case Direction::UP:
+            return Direction::DOWN;
+        case Direction::DOWN:
+            return Direction::UP;
+        case Direction::LEFT:
+            return Direction::RIGHT;
+        case Direction::RIGHT:
+            return Direction::LEFT;
+        default:
+            return Direction::NONE;
+    }
+}
+
+/**
+ * @brief Swaps horizontal and vertical directions, used for boards walked column by column
+ */
+Direction transpose(Direction dir)
+{
+    switch (dir) {
+        case Direction::UP:
+            return Direction::LEFT;
+        case Direction::DOWN:
+            return Direction::RIGHT;
+        case Direction::LEFT:
+            return Direction::UP;
+        case Direction::RIGHT:
+            return Direction::DOWN;
+        default:
+            return Direction::NONE;
+    }
+}
+
+/**
+ * @brief Direction of a Hamiltonian cycle on a width x height board with an even height
+ *
+ * Row 0 is walked to the right, the remaining rows snake between column 1 and the last
+ * column and column 0 leads back up to the start. The board edges are not crossed.
+ */
+Direction getEvenCycleDirection(int x, int y, int width, int height)
+{
+    if (y == 0) return x < width - 1 ? Direction::RIGHT : Direction::DOWN;
+    if (x == 0) return Direction::UP;
+    if (y % 2 == 0) return x < width - 1 ? Direction::RIGHT : Direction::DOWN;
+    if (x > 1 || y == height - 1) return Direction::LEFT;
+    return Direction::DOWN;
+}
+
+/**
+ * @brief Direction of a Hamiltonian cycle on a board with an odd width and height
+ *
+ * Uses the even cycle on all rows but the last. On the last row of that cycle, the
+ * step from column 2 to column 1 is replaced by a detour through the last board row.
+ * The detour walks that row to the right from column 2 and wraps around the board edge
+ * back to column 1.
+ */
+Direction getOddCycleDirection(int x, int y, int width, int height)
+{
+    if (y == height - 1) return x == 1 ? Direction::UP : Direction::RIGHT;
+    if (y == height - 2 && x == 2) return Direction::DOWN;
+    return getEvenCycleDirection(x, y, width, height - 1);
+}
+}  // namespace
+
+/**
+ * @brief Constructor for the Autopilot class
+ *
+ * @param grid Board the autopilot plays on
+ * @param budget Maximum time a single chooseDirection() call may search
+ *
+ * Walks the Hamiltonian cycle once to number its cells and allocates the search buffers.
+ */
+Autopilot::Autopilot(const Grid &grid, std::chrono::microseconds budget)
+    : grid(grid),
+      budget(budget),
+      deadline(),
+      cycleIndices(grid.getCellCount(), 0),
+      visitedStamps(grid.getCellCount(), 0),
+      blockedStamps(grid.getCellCount(), 0),
+      parents(grid.getCellCount(), -1),
+      distances(grid.getCellCount(), 0),
+      queue(grid.getCellCount(), 0),
+      path(),
+      visitedStamp(0),
+      blockedStamp(0),
+      timedOut(false)
+{
+    path.reserve(grid.getCellCount());
+    int cell = 0;
+    for (int index = 0; index < grid.getCellCount(); index++) {
+        cycleIndices[cell] = index;
+        cell = getNeighbor(cell, getCycleDirection(grid.getCellPosition(cell)));
+    }
+}
+
+/**
+ * @brief Chooses the direction for the next tick
+ *
+ * @param sim Game to steer
+ * @return Direction Direction to pass to SnakeSim::step()
+ */
+Direction Autopilot::chooseDirection(const SnakeSim &sim)
+{
+    deadline = std::chrono::steady_clock::now() + budget;
+    timedOut = false;
+
+    bool pathFound = findPathToFood(sim);
+    Direction dir = Direction::NONE;
+    if (isInCycleOrder(sim)) {
+        dir = findCycleDirection(sim, pathFound);
+    } else if (pathFound && isSafeAfterPath(sim)) {
+        dir = getDirectionTo(grid.getCellIndex(sim.getSnake().body.front()), path.front());
+    }
+
+    if (dir == Direction::NONE && !timedOut) dir = findTailChaseDirection(sim);
+    if (dir == Direction::NONE) dir = findEscapeDirection(sim);
+    return dir != Direction::NONE ? dir : sim.getSnake().getDirection();
+}
+
+/**
+ * @brief Gets the direction of the Hamiltonian cycle at a cell
+ *
+ * @param position Cell on the board
+ * @return Direction Step to the next cell of the cycle
+ *
+ * Boards with an even height use the even cycle, boards with an even width use it
+ * column by column and boards where both are odd use the detour through the last row.
+ */
+Direction Autopilot::getCycleDirection(const Position &position) const
+{
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    if (height % 2 == 0) return getEvenCycleDirection(position.x, position.y, width, height);
+    if (width % 2 == 0) return transpose(getEvenCycleDirection(position.y, position.x, height, width));
+    return getOddCycleDirection(position.x, position.y, width, height);
+}
+
+/**
+ * @brief Checks whether the last chooseDirection() call ran out of time for its searches
+ */
+bool Autopilot::hasTimedOut() const { return timedOut; }
+
+/**
+ * @brief Gets the neighboring cell in a direction, wrapping around the board edges
+ */
+int Autopilot::getNeighbor(int cell, Direction dir) const
+{
+    Position position = grid.getCellPosition(cell);
+    int x = position.x + (dir == Direction::RIGHT) - (dir == Direction::LEFT);
+    int y = position.y + (dir == Direction::DOWN) - (dir == Direction::UP);
+    return grid.getCellIndex(grid.wrap(x, y));
+}
+
+/**
+ * @brief Gets the direction that leads from a cell to a neighboring cell
+ */
+Direction Autopilot::getDirectionTo(int from, int to) const
+{
+    for (Direction dir : DIRECTIONS) {
+        if (getNeighbor(from, dir) == to) return dir;
+    }
+    return Direction::NONE;
+}
+
+/**
+ * @brief Gets how many steps along the cycle lead from one cell to another
+ */
+int Autopilot::getCycleDistance(int from, int to) const
+{
+    int distance = cycleIndices[to] - cycleIndices[from];
+    return distance < 0 ? distance + grid.getCellCount() : distance;
+}
+
+/**
+ * @brief Checks whether the snake can enter a cell on its next move without colliding
+ *
+ * The tail cell counts as open, since the tail moves on when the snake does not eat.
+ */
+bool Autopilot::isOpen(const SnakeSim &sim, int cell) const
+{
+    return !sim.getOccupancy().test(cell) || cell == grid.getCellIndex(sim.getSnake().body.back());
+}
+
+/**
+ * @brief Checks whether the body lies in cycle order within less than one lap
+ */
+bool Autopilot::isInCycleOrder(const SnakeSim &sim) const
+{
+    const SnakeBody &body = sim.getSnake().body;
+    int span = 0;
+    for (int i = body.size() - 1; i > 0; i--) {
+        int step = getCycleDistance(grid.getCellIndex(body[i]), grid.getCellIndex(body[i - 1]));
+        if (step == 0) return false;
+        span += step;
+        if (span >= grid.getCellCount()) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether moving the head to a neighboring cell keeps the body in cycle order
+ *
+ * @param cell Neighbor of the head
+ * @return true if the cell is open and lies ahead of the head on the cycle, not beyond the tail
+ */
+bool Autopilot::isCycleSafe(const SnakeSim &sim, int cell) const
+{
+    const SnakeBody &body = sim.getSnake().body;
+    if (!isOpen(sim, cell)) return false;
+    if (body.size() == 1) return true;
+
+    int head = grid.getCellIndex(body.front());
+    int step = getCycleDistance(head, cell);
+    return step > 0 && step <= getCycleDistance(head, grid.getCellIndex(body.back()));
+}
+
+/**
+ * @brief Starts a new virtual board on which only the walls are blocked
+ *
+ * Cells are blocked on the virtual board by setting their stamp to blockedStamp.
+ */
+void Autopilot::startVirtualBoard(const SnakeSim &sim)
+{
+    blockedStamp++;
+    for (const Position &wallPosition : sim.getWallPositions()) {
+        blockedStamps[grid.getCellIndex(wallPosition)] = blockedStamp;
+    }
+}
+
+/**
+ * @brief Breadth-first search from a cell to a target cell
+ *
+ * @param start Cell the search starts at
+ * @param target Cell to reach, it can always be entered
+ * @param virtualBoard Whether to use the virtual board instead of the current occupancy
+ * @param sim Game the search runs on
+ * @param forbidden Direction that must not be taken from the start cell, the reverse of the current one
+ * @return true if the target was reached within the time budget, parents and distances then describe the path
+ */
+bool Autopilot::search(int start, int target, bool virtualBoard, const SnakeSim &sim, Direction forbidden)
+{
+    visitedStamp++;
+    visitedStamps[start] = visitedStamp;
+    distances[start] = 0;
+
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = start;
+    while (head < tail) {
+        if (head % CLOCK_CHECK_INTERVAL == CLOCK_CHECK_INTERVAL - 1 && isPastDeadline(deadline)) {
+            timedOut = true;
+            return false;
+        }
+
+        int cell = queue[head++];
+        for (Direction dir : DIRECTIONS) {
+            if (cell == start && dir == forbidden) continue;
+
+            int neighbor = getNeighbor(cell, dir);
+            if (visitedStamps[neighbor] == visitedStamp) continue;
+            bool blocked = virtualBoard ? blockedStamps[neighbor] == blockedStamp : !isOpen(sim, neighbor);
+            if (blocked && neighbor != target) continue;
+
+            visitedStamps[neighbor] = visitedStamp;
+            parents[neighbor] = cell;
+            distances[neighbor] = distances[cell] + 1;
+            if (neighbor == target) return true;
+            queue[tail++] = neighbor;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Searches the shortest path from the head to the food
+ *
+ * @return true if a path was found, it is stored in path from the first step up to the food cell
+ */
+bool Autopilot::findPathToFood(const SnakeSim &sim)
+{
+    const Snake &snake = sim.getSnake();
+    int head = grid.getCellIndex(snake.body.front());
+    int food = grid.getCellIndex(sim.getFoodPosition());
+    path.clear();
+    if (!search(head, food, false, sim, getOpposite(snake.getDirection()))) return false;
+
+    for (int cell = food; cell != head; cell = parents[cell]) {
+        path.push_back(cell);
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+/**
+ * @brief Checks whether the snake could still reach its tail after following the path
+ *
+ * Builds the body the snake would have after eating at the end of the path on the
+ * virtual board and searches a way from the new head to the new tail.
+ */
+bool Autopilot::isSafeAfterPath(const SnakeSim &sim)
+{
+    const SnakeBody &body = sim.getSnake().body;
+    int pathLength = (int) path.size();
+    int newLength = body.size() + 1;
+
+    startVirtualBoard(sim);
+    int newTail = -1;
+    for (int i = 0; i < newLength; i++) {
+        newTail = i < pathLength ? path[pathLength - 1 - i] : grid.getCellIndex(body[i - pathLength]);
+        blockedStamps[newTail] = blockedStamp;
+    }
+
+    int newHead = path.back();
+    int beforeHead = pathLength > 1 ? path[pathLength - 2] : grid.getCellIndex(body.front());
+    return search(newHead, newTail, true, sim, getOpposite(getDirectionTo(beforeHead, newHead)));
+}
+
+/**
+ * @brief Chooses a move that keeps the body in cycle order
+ *
+ * @param pathFound Whether path holds the shortest path to the food
+ * @return Direction First step of the path if it keeps the order without skipping the food, else the
+ *         largest shortcut along the cycle that does not skip the food, Direction::NONE if no move keeps the order
+ */
+Direction Autopilot::findCycleDirection(const SnakeSim &sim, bool pathFound) const
+{
+    const Snake &snake = sim.getSnake();
+    int head = grid.getCellIndex(snake.body.front());
+    int foodDistance = getCycleDistance(head, grid.getCellIndex(sim.getFoodPosition()));
+    if (pathFound && isCycleSafe(sim, path.front()) && getCycleDistance(head, path.front()) <= foodDistance) {
+        return getDirectionTo(head, path.front());
+    }
+
+    Direction forbidden = getOpposite(snake.getDirection());
+    Direction best = Direction::NONE;
+    int bestStep = 0;
+    for (Direction dir : DIRECTIONS) {
+        int next = getNeighbor(head, dir);
+        if (dir == forbidden || !isCycleSafe(sim, next)) continue;
+
+        int step = getCycleDistance(head, next);
+        bool better = step <= foodDistance ? (bestStep > foodDistance || step > bestStep) : step < bestStep;
+        if (best == Direction::NONE || better) {
+            best = dir;
+            bestStep = step;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Finds the move that keeps the tail reachable by the longest route
+ *
+ * @return Direction Move to make, Direction::NONE if every move cuts the snake off from its tail
+ */
+Direction Autopilot::findTailChaseDirection(const SnakeSim &sim)
+{
+    const Snake &snake = sim.getSnake();
+    const SnakeBody &body = snake.body;
+    int head = grid.getCellIndex(body.front());
+    int food = grid.getCellIndex(sim.getFoodPosition());
+    Direction forbidden = getOpposite(snake.getDirection());
+
+    Direction best = Direction::NONE;
+    int bestDistance = -1;
+    for (Direction dir : DIRECTIONS) {
+        int next = getNeighbor(head, dir);
+        if (dir == forbidden || !isOpen(sim, next)) continue;
+
+        int newLength = body.size() + (next == food);
+        if (newLength == 1) return dir;
+
+        startVirtualBoard(sim);
+        blockedStamps[next] = blockedStamp;
+        int newTail = next;
+        for (int i = 0; i < newLength - 1; i++) {
+            newTail = grid.getCellIndex(body[i]);
+            blockedStamps[newTail] = blockedStamp;
+        }
+
+        if (search(next, newTail, true, sim, getOpposite(dir)) && distances[newTail] > bestDistance) {
+            bestDistance = distances[newTail];
+            best = dir;
+        }
+        if (timedOut) break;
+    }
+    return best;
+}
+
+/**
+ * @brief Finds the open move with the most room, the last resort when the tail is cut off
+ *
+ * @return Direction Move with the largest reachable area within the time budget,
+ *         Direction::NONE if every move collides
+ */
+Direction Autopilot::findEscapeDirection(const SnakeSim &sim)
+{
+    const Snake &snake = sim.getSnake();
+    int head = grid.getCellIndex(snake.body.front());
+    Direction forbidden = getOpposite(snake.getDirection());
+
+    Direction best = Direction::NONE;
+    int bestRoom = -1;
+    for (Direction dir : DIRECTIONS) {
+        int start = getNeighbor(head, dir);
+        if (dir == forbidden || !isOpen(sim, start)) continue;
+
+        visitedStamp++;
+        visitedStamps[head] = visitedStamp;
+        visitedStamps[start] = visitedStamp;
+        int queueHead = 0;
+        int queueTail = 0;
+        queue[queueTail++] = start;
+        while (queueHead < queueTail && (queueHead % CLOCK_CHECK_INTERVAL != 0 || !isPastDeadline(deadline))) {
+            int cell = queue[queueHead++];
+            for (Direction next : DIRECTIONS) {
+                int neighbor = getNeighbor(cell, next);
+                if (visitedStamps[neighbor] == visitedStamp || !isOpen(sim, neighbor)) continue;
+                visitedStamps[neighbor] = visitedStamp;
+                queue[queueTail++] = neighbor;
+            }
+        }
+
+        if (queueTail > bestRoom) {
+            bestRoom = queueTail;
+            best = dir;
+        }
+    }
+    return best;
+}
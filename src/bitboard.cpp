@@ -0,0 +1,68 @@
+/**
+ * @file bitboard.cpp
+ * @brief Implementation of the Bitboard class
+ *
+ * A bitboard stores one bit per grid cell, packed into 64-bit words. The simulation
+ * uses it as its occupancy grid for the snake body and the walls, so that collision
+ * and overlap checks are a single bit test instead of a scan over all segments.
+ */
+
+#include "../include/bitboard.h"
+
+#include <algorithm>
+#include <bit>
+
+/**
+ * @brief Constructs a bitboard with all cells cleared
+ *
+ * @param cellCount Number of cells on the grid
+ */
+Bitboard::Bitboard(int cellCount) : words((cellCount + 63) / 64, 0) {}
+
+/**
+ * @brief Clears all cells
+ */
+void Bitboard::clear() { std::fill(words.begin(), words.end(), 0); }
+
+/**
+ * @brief Marks a cell as occupied
+ *
+ * @param cell Index of the cell
+ */
+void Bitboard::set(int cell) { words[cell >> 6] |= uint64_t{1} << (cell & 63); }
+
+/**
+ * @brief Marks a cell as free
+ *
+ * @param cell Index of the cell
+ */
+void Bitboard::reset(int cell) { words[cell >> 6] &= ~(uint64_t{1} << (cell & 63)); }
+
+/**
+ * @brief Checks whether a cell is occupied
+ *
+ * @param cell Index of the cell
+ * @return true if the cell's bit is set, false otherwise
+ */
+bool Bitboard::test(int cell) const { return (words[cell >> 6] >> (cell & 63)) & 1; }
+
+/**
+ * @brief Counts the occupied cells
+ *
+ * @return int Number of set bits
+ */
+int Bitboard::count() const
+{
+    int total = 0;
+    for (uint64_t word : words) {
+        total += std::popcount(word);
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the packed bits, cell i is bit (i % 64) of word (i / 64)
+ *
+ * @return const std::vector<uint64_t>& Words of the bitboard, unused bits of the last word are zero
+ */
+const std::vector<uint64_t> &Bitboard::getWords() const { return words; }
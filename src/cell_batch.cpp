@@ -0,0 +1,98 @@
+/**
+ * @file cell_batch.cpp
+ * @brief Implementation of the CellBatch class, which draws many board cells at once
+ *
+ * Drawing every cell with its own DrawRectangle call costs a function call, a batch limit
+ * check and a texture switch per cell, which adds up to thousands of calls per frame for a
+ * long snake. The batch instead collects the cell quads of a frame in a preallocated
+ * buffer and submits them in chunks through rlgl, which keeps them in its vertex buffer
+ * and renders each full buffer with a single draw call.
+ */
+
+#include "../include/cell_batch.h"
+
+#include <algorithm>
+
+#include "../include/constants.h"
+#include "rlgl.h"
+
+/**
+ * @brief Constructor for the CellBatch class
+ */
+CellBatch::CellBatch() : quads() {}
+
+/**
+ * @brief Reserves space for a number of cells, so adding them does not allocate
+ *
+ * @param capacity Maximum number of cells drawn in one frame, e.g. all cells of the board
+ */
+void CellBatch::reserve(int capacity)
+{
+    quads.reserve(capacity);
+}
+
+/**
+ * @brief Removes all cells, keeping the allocated space
+ */
+void CellBatch::clear()
+{
+    quads.clear();
+}
+
+/**
+ * @brief Adds a filled cell to the batch
+ *
+ * @param rectangle Screen area of the cell in pixels
+ * @param color Fill color of the cell
+ */
+void CellBatch::add(Rectangle rectangle, Color color)
+{
+    quads.push_back(Quad{rectangle, color});
+}
+
+/**
+ * @brief Submits all cells to the current rlgl render batch
+ *
+ * The cells are submitted in chunks of Constants::CELL_BATCH_QUADS quads, which fit into
+ * the smallest default render batch of raylib. Before each chunk rlgl flushes its buffer
+ * if the chunk does not fit anymore, so the cells cost one draw call per full buffer.
+ * Cells are drawn in the order they were added.
+ *
+ * @return int Number of chunks submitted, an upper bound of the draw calls issued
+ */
+int CellBatch::submit() const
+{
+    int chunks = 0;
+    for (size_t begin = 0; begin < quads.size(); begin += Constants::CELL_BATCH_QUADS) {
+        size_t end = std::min(quads.size(), begin + Constants::CELL_BATCH_QUADS);
+        rlCheckRenderBatchLimit((int) (end - begin) * 4);
+
+        rlSetTexture(rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        for (size_t i = begin; i < end; i++) {
+            const Rectangle &rectangle = quads[i].rectangle;
+            const Color &color = quads[i].color;
+            float right = rectangle.x + rectangle.width;
+            float bottom = rectangle.y + rectangle.height;
+            rlColor4ub(color.r, color.g, color.b, color.a);
+            rlVertex2f(rectangle.x, rectangle.y);
+            rlVertex2f(rectangle.x, bottom);
+            rlVertex2f(right, bottom);
+            rlVertex2f(right, rectangle.y);
+        }
+        rlEnd();
+        rlSetTexture(0);
+        chunks++;
+    }
+    return chunks;
+}
+
+/**
+ * @brief Returns the number of cells added since the last clear
+ *
+ * @return int Number of cells in the batch
+ */
+int CellBatch::getCellCount() const
+{
+    return (int) quads.size();
+}
@@ -0,0 +1,224 @@
+/**
+ * @file evilsnake.cpp
+ * @brief Implementation of the C API of the libevilsnake shared library
+ *
+ * Wraps SnakeSim behind an opaque handle and plain C types, so the game rules can be
+ * driven via FFI from other languages without the raylib game. Each handle is an
+ * independent game; handles may be used from different threads as long as a single
+ * handle is not used concurrently. No C++ exception crosses the API boundary.
+ */
+
+#include "../include/evilsnake.h"
+
+#include "../include/game_config.h"
+#include "../include/snake_sim.h"
+#include "../include/vec_snake_env.h"
+
+struct EvilSnake {
+    SnakeSim sim;
+};
+
+namespace
+{
+/**
+ * @brief Converts the C configuration into a GameConfig, keeping the rendering defaults
+ */
+GameConfig toGameConfig(const EvilSnakeConfig &config)
+{
+    GameConfig gameConfig;
+    gameConfig.cellAmountX = config.board_width;
+    gameConfig.cellAmountY = config.board_height;
+    gameConfig.viewCellAmountX = config.board_width;
+    gameConfig.viewCellAmountY = config.board_height;
+    gameConfig.winningScore = config.winning_score;
+    gameConfig.wallAmount = config.wall_amount;
+    gameConfig.defaultSnakeSpeed = config.default_speed;
+    gameConfig.fastSnakeSpeed = config.fast_speed;
+    gameConfig.eventInterval = config.event_interval;
+    return gameConfig;
+}
+}  // namespace
+
+/**
+ * @brief Gets the ABI version the library was built with
+ *
+ * @return uint32_t EVILSNAKE_ABI_VERSION of the library, compare it to the header's
+ */
+uint32_t evilsnake_abi_version(void) { return EVILSNAKE_ABI_VERSION; }
+
+/**
+ * @brief Fills a configuration with the rules of the regular game
+ *
+ * @param config Configuration to fill
+ */
+void evilsnake_default_config(EvilSnakeConfig *config)
+{
+    if (config == nullptr) return;
+
+    GameConfig defaults;
+    config->board_width = defaults.cellAmountX;
+    config->board_height = defaults.cellAmountY;
+    config->winning_score = defaults.winningScore;
+    config->wall_amount = defaults.wallAmount;
+    config->default_speed = defaults.defaultSnakeSpeed;
+    config->fast_speed = defaults.fastSnakeSpeed;
+    config->event_interval = defaults.eventInterval;
+}
+
+/**
+ * @brief Creates a new game
+ *
+ * @param config Board size and rules, or NULL for the regular game
+ * @param seed Seed of the game, equal seeds and inputs give equal games
+ * @return EvilSnake* Handle of the game, NULL if the configuration is invalid or memory ran out
+ */
+EvilSnake *evilsnake_create(const EvilSnakeConfig *config, uint64_t seed)
+{
+    EvilSnakeConfig defaults;
+    evilsnake_default_config(&defaults);
+    GameConfig gameConfig = toGameConfig(config != nullptr ? *config : defaults);
+    if (!ConfigLoader::validate(gameConfig)) return nullptr;
+
+    try {
+        return new EvilSnake{SnakeSim(gameConfig, seed)};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Destroys a game, NULL is ignored
+ */
+void evilsnake_destroy(EvilSnake *game) { delete game; }
+
+/**
+ * @brief Starts a new game on the same board with the same rules
+ *
+ * @param seed Seed of the new game
+ */
+void evilsnake_reset(EvilSnake *game, uint64_t seed)
+{
+    if (game != nullptr) game->sim.reset(seed);
+}
+
+/**
+ * @brief Advances the game by one tick
+ *
+ * @param direction One of EVILSNAKE_DIRECTION_*, NONE keeps the current direction
+ * @param result Receives the events of the tick and the new state, may be NULL
+ * @return int32_t Status after the tick, EVILSNAKE_STATUS_ERROR for a NULL game or an invalid direction
+ *
+ * Stepping an ended game does nothing until it is reset.
+ */
+int32_t evilsnake_step(EvilSnake *game, int32_t direction, EvilSnakeStepResult *result)
+{
+    if (game == nullptr || direction < EVILSNAKE_DIRECTION_NONE || direction > EVILSNAKE_DIRECTION_RIGHT) {
+        return EVILSNAKE_STATUS_ERROR;
+    }
+
+    SnakeSim &sim = game->sim;
+    StepResult step = sim.step((Direction) direction);
+    if (result != nullptr) {
+        result->ate_food = step.ateFood;
+        result->collided = step.collided;
+        result->mode_changed = step.modeChanged;
+        result->finished = step.finished;
+        result->status = (int32_t) sim.getStatus();
+        result->score = sim.getScore();
+        result->mode = (int32_t) sim.getMode();
+        result->ticks = sim.getTicks();
+        result->elapsed_time = sim.getElapsedTime();
+    }
+    return (int32_t) sim.getStatus();
+}
+
+/**
+ * @brief Gets the number of bytes an observation needs
+ *
+ * @return size_t Width * height, 0 for a NULL game
+ */
+size_t evilsnake_observation_size(const EvilSnake *game)
+{
+    return game != nullptr ? (size_t) game->sim.getGrid().getCellCount() : 0;
+}
+
+/**
+ * @brief Writes the board into a caller-provided buffer
+ *
+ * @param buffer Receives one EVILSNAKE_CELL_* byte per cell in row-major order
+ * @param size Size of the buffer, at least evilsnake_observation_size()
+ * @return int32_t 0 on success, -1 for a NULL game or buffer or a buffer that is too small
+ *
+ * The board is written directly into the buffer, nothing is allocated or copied in between.
+ */
+int32_t evilsnake_observe(const EvilSnake *game, uint8_t *buffer, size_t size)
+{
+    if (game == nullptr || buffer == nullptr || size < evilsnake_observation_size(game)) return -1;
+
+    VecSnakeEnv::writeObservation(game->sim, buffer);
+    return 0;
+}
+
+/**
+ * @brief Gets the seed of the current game
+ */
+uint64_t evilsnake_get_seed(const EvilSnake *game) { return game != nullptr ? game->sim.getSeed() : 0; }
+
+/**
+ * @brief Gets the board width in cells
+ */
+int32_t evilsnake_get_width(const EvilSnake *game) { return game != nullptr ? game->sim.getGrid().getWidth() : 0; }
+
+/**
+ * @brief Gets the board height in cells
+ */
+int32_t evilsnake_get_height(const EvilSnake *game) { return game != nullptr ? game->sim.getGrid().getHeight() : 0; }
+
+/**
+ * @brief Gets the status of the game, one of EVILSNAKE_STATUS_*
+ */
+int32_t evilsnake_get_status(const EvilSnake *game)
+{
+    return game != nullptr ? (int32_t) game->sim.getStatus() : EVILSNAKE_STATUS_ERROR;
+}
+
+/**
+ * @brief Gets the current score
+ */
+int32_t evilsnake_get_score(const EvilSnake *game) { return game != nullptr ? game->sim.getScore() : 0; }
+
+/**
+ * @brief Gets the number of ticks of the current game
+ */
+int64_t evilsnake_get_ticks(const EvilSnake *game) { return game != nullptr ? game->sim.getTicks() : 0; }
+
+/**
+ * @brief Gets the direction the snake moves in on its next tick, one of EVILSNAKE_DIRECTION_*
+ */
+int32_t evilsnake_get_direction(const EvilSnake *game)
+{
+    return game != nullptr ? (int32_t) game->sim.getSnake().getDirection() : EVILSNAKE_DIRECTION_NONE;
+}
+
+/**
+ * @brief Writes the cells of the snake into a caller-provided buffer
+ *
+ * @param cells Receives the row-major cell index of every segment from the head to the tail
+ * @param size Number of entries of the buffer, evilsnake_observation_size() always suffices
+ * @return int32_t Length of the snake, -1 for a NULL game or buffer or a buffer that is too small
+ *
+ * The observation has no order of the segments, this is how bots learn which end is the tail.
+ */
+int32_t evilsnake_get_snake(const EvilSnake *game, int32_t *cells, size_t size)
+{
+    if (game == nullptr || cells == nullptr) return -1;
+
+    const Grid &grid = game->sim.getGrid();
+    const SnakeBody &body = game->sim.getSnake().body;
+    if (size < (size_t) body.size()) return -1;
+
+    for (int i = 0; i < body.size(); i++) {
+        cells[i] = grid.getCellIndex(body[i]);
+    }
+    return body.size();
+}
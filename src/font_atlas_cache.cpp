@@ -0,0 +1,240 @@
+/**
+ * @file font_atlas_cache.cpp
+ * @brief Cache of rasterized font atlases, so fonts are not rasterized on every launch
+ *
+ * Rasterizing the glyphs of a TTF font and packing them into an atlas takes most of the
+ * startup time. After a font has been rasterized once, its atlas image and glyph metrics
+ * are stored in a cache file, and later launches map that file into memory and upload the
+ * atlas straight from the mapping into a texture.
+ *
+ * File layout, in the byte order of the machine, since the cache never leaves it:
+ * - CacheHeader: magic "ESFA", format version, size and modification time of the TTF
+ *   file, font size, glyph count, glyph padding, SDF flag and the atlas image format
+ * - One CachedGlyph per glyph: codepoint, offsets, advance and atlas rectangle
+ * - The atlas pixels as stored in the raylib image
+ *
+ * A cache file is only used if all of its header matches the requested font and the
+ * current TTF file, otherwise the font is rasterized again and the file replaced. Files
+ * are written to a temporary path first and renamed, so a crash never leaves a partial
+ * cache behind.
+ */
+
+#include "../include/font_atlas_cache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FONT_ATLAS_CACHE_MMAP
+#endif
+
+namespace
+{
+constexpr char CACHE_MAGIC[4] = {'E', 'S', 'F', 'A'};
+constexpr uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    int32_t fontSize;
+    int32_t glyphCount;
+    int32_t glyphPadding;
+    int32_t sdf;
+    int32_t atlasWidth;
+    int32_t atlasHeight;
+    int32_t atlasFormat;
+    uint32_t atlasBytes;
+};
+
+struct CachedGlyph {
+    int32_t value;
+    int32_t offsetX;
+    int32_t offsetY;
+    int32_t advanceX;
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+/**
+ * @brief Reads the size and modification time of the TTF file a cache was built from
+ *
+ * @param sourcePath Path of the TTF file
+ * @param size Receives the file size in bytes
+ * @param time Receives the modification time in file clock ticks
+ * @return true if the file exists and both could be read, false otherwise
+ */
+bool getSourceStamp(const std::string &sourcePath, uint64_t &size, int64_t &time)
+{
+    std::error_code error;
+    size = std::filesystem::file_size(sourcePath, error);
+    if (error) return false;
+    time = std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+    return !error;
+}
+
+/**
+ * @brief Creates a font from the mapped content of a cache file
+ *
+ * @param data Content of the cache file
+ * @param size Size of the content in bytes
+ * @param header Expected header, compared field by field with the one in the file
+ * @param font Receives the font, its texture is uploaded from the mapped atlas pixels
+ * @return true if the content matches the header and is complete, false otherwise
+ */
+bool readCache(const unsigned char *data, size_t size, const CacheHeader &header, Font &font)
+{
+    if (size < sizeof(CacheHeader)) return false;
+
+    CacheHeader stored;
+    std::memcpy(&stored, data, sizeof(CacheHeader));
+    if (std::memcmp(stored.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || stored.version != header.version ||
+        stored.sourceSize != header.sourceSize || stored.sourceTime != header.sourceTime ||
+        stored.fontSize != header.fontSize || stored.glyphCount != header.glyphCount || stored.sdf != header.sdf) {
+        return false;
+    }
+
+    size_t glyphBytes = stored.glyphCount * sizeof(CachedGlyph);
+    size_t atlasBytes = GetPixelDataSize(stored.atlasWidth, stored.atlasHeight, stored.atlasFormat);
+    if (stored.atlasWidth <= 0 || stored.atlasHeight <= 0 || atlasBytes == 0 || stored.atlasBytes != atlasBytes ||
+        size != sizeof(CacheHeader) + glyphBytes + atlasBytes) {
+        return false;
+    }
+
+    font = Font{};
+    font.baseSize = stored.fontSize;
+    font.glyphCount = stored.glyphCount;
+    font.glyphPadding = stored.glyphPadding;
+    font.glyphs = (GlyphInfo *) MemAlloc(stored.glyphCount * sizeof(GlyphInfo));
+    font.recs = (Rectangle *) MemAlloc(stored.glyphCount * sizeof(Rectangle));
+    const unsigned char *glyphData = data + sizeof(CacheHeader);
+    for (int i = 0; i < stored.glyphCount; i++) {
+        CachedGlyph glyph;
+        std::memcpy(&glyph, glyphData + i * sizeof(CachedGlyph), sizeof(CachedGlyph));
+        font.glyphs[i] = GlyphInfo{glyph.value, glyph.offsetX, glyph.offsetY, glyph.advanceX, Image{}};
+        font.recs[i] = Rectangle{glyph.x, glyph.y, glyph.width, glyph.height};
+    }
+
+    Image atlas = {(void *) (glyphData + glyphBytes), stored.atlasWidth, stored.atlasHeight, 1, stored.atlasFormat};
+    font.texture = LoadTextureFromImage(atlas);
+    return true;
+}
+}  // namespace
+
+/**
+ * @brief Loads a font from its cache file if the cache matches the font
+ *
+ * @param cachePath Path of the cache file
+ * @param sourcePath Path of the TTF file the font is created from
+ * @param fontSize Size the glyphs were rasterized at
+ * @param glyphCount Number of glyphs, starting at codepoint 32
+ * @param sdf Whether the glyphs are signed distance fields
+ * @param font Receives the font, only written on success
+ * @return true if the font was loaded from the cache, false if it has to be rasterized
+ */
+bool FontAtlasCache::load(
+    const std::string &cachePath, const std::string &sourcePath, int fontSize, int glyphCount, bool sdf, Font &font)
+{
+    CacheHeader header = {};
+    header.version = CACHE_VERSION;
+    header.fontSize = fontSize;
+    header.glyphCount = glyphCount;
+    header.sdf = sdf ? 1 : 0;
+    if (!getSourceStamp(sourcePath, header.sourceSize, header.sourceTime)) return false;
+
+#ifdef FONT_ATLAS_CACHE_MMAP
+    int file = open(cachePath.c_str(), O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size <= 0) {
+        close(file);
+        return false;
+    }
+
+    size_t size = (size_t) status.st_size;
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED) return false;
+
+    bool loaded = readCache((const unsigned char *) mapping, size, header, font);
+    munmap(mapping, size);
+    return loaded;
+#else
+    int size = 0;
+    unsigned char *data = LoadFileData(cachePath.c_str(), &size);
+    if (data == nullptr) return false;
+
+    bool loaded = readCache(data, (size_t) size, header, font);
+    UnloadFileData(data);
+    return loaded;
+#endif
+}
+
+/**
+ * @brief Stores a rasterized font in a cache file
+ *
+ * @param cachePath Path of the cache file, its directory is created if needed
+ * @param sourcePath Path of the TTF file the font was created from
+ * @param font Rasterized font with its glyph metrics and atlas rectangles
+ * @param atlas Atlas image the font's texture was created from
+ * @param sdf Whether the glyphs are signed distance fields
+ * @return true if the cache file was written, false otherwise
+ */
+bool FontAtlasCache::save(
+    const std::string &cachePath, const std::string &sourcePath, const Font &font, const Image &atlas, bool sdf)
+{
+    CacheHeader header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.fontSize = font.baseSize;
+    header.glyphCount = font.glyphCount;
+    header.glyphPadding = font.glyphPadding;
+    header.sdf = sdf ? 1 : 0;
+    header.atlasWidth = atlas.width;
+    header.atlasHeight = atlas.height;
+    header.atlasFormat = atlas.format;
+    header.atlasBytes = GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+    if (!getSourceStamp(sourcePath, header.sourceSize, header.sourceTime) || atlas.data == nullptr) return false;
+
+    std::error_code error;
+    std::filesystem::path path(cachePath);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::string temporaryPath = cachePath + ".tmp";
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Could not create font cache file: " << temporaryPath << std::endl;
+        return false;
+    }
+
+    file.write((const char *) &header, sizeof(header));
+    for (int i = 0; i < font.glyphCount; i++) {
+        const GlyphInfo &glyph = font.glyphs[i];
+        const Rectangle &rec = font.recs[i];
+        CachedGlyph cached = {
+            glyph.value, glyph.offsetX, glyph.offsetY, glyph.advanceX, rec.x, rec.y, rec.width, rec.height};
+        file.write((const char *) &cached, sizeof(cached));
+    }
+    file.write((const char *) atlas.data, header.atlasBytes);
+    file.close();
+
+    if (!file) {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    std::filesystem::rename(temporaryPath, cachePath, error);
+    return !error;
+}
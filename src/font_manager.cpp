@@ -1,17 +1,89 @@
 /**
  * @file font_manager.cpp
- * @brief Implementation of the FontManager singleton class
+ * @brief Implementation of the FontManager class
  *
  * This file implements a font resource manager that handles loading,
  * storing, and providing access to different fonts used in the game.
- * It follows the singleton pattern to ensure a single point of font management.
+ * It is the resource context of the game: one instance is created after the
+ * window and shared by every screen that draws text.
+ *
+ * Rasterizing the fonts dominates the startup time, so rasterized fonts are stored in a
+ * FontAtlasCache and loaded from it on later launches. Optionally the fonts are
+ * rasterized as signed distance fields, which render crisply at every size from a single
+ * smaller atlas, with a shader that turns the distances into coverage.
  */
 
 #include "../include/font_manager.h"
 
 #include <raylib.h>
 
+#include <chrono>
+
+#include "../include/constants.h"
+#include "../include/font_atlas_cache.h"
 #include "../include/game_utils.h"
+#include "../include/tracing.h"
+
+namespace
+{
+/**
+ * @brief Fragment shader for signed distance field fonts (GLSL 3.30)
+ *
+ * Turns the distance stored in the atlas' alpha channel into the glyph's coverage, with
+ * an edge as wide as one screen pixel at any scale. Opaque pixels without a gradient, like
+ * the white pixel shapes are drawn with, stay opaque.
+ */
+const char *SDF_FRAGMENT_SHADER = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+out vec4 finalColor;
+
+void main()
+{
+    float distance = texture(texture0, fragTexCoord).a - 0.5;
+    float edgeWidth = max(length(vec2(dFdx(distance), dFdy(distance))), 0.0001);
+    float coverage = smoothstep(-edgeWidth, edgeWidth, distance);
+    finalColor = vec4(fragColor.rgb, fragColor.a * coverage);
+}
+)";
+
+/**
+ * @brief Rasterizes a TTF font into a font with an atlas texture
+ *
+ * @param sourcePath Path of the TTF file
+ * @param sdf Whether to rasterize signed distance fields instead of coverage
+ * @param cachePath Cache file to store the rasterized font in, or an empty string
+ * @return Font The rasterized font, or raylib's default font if the file cannot be loaded
+ *
+ * Does the same as LoadFontEx(), but keeps the atlas image until it has been cached.
+ */
+Font rasterizeFont(const std::string &sourcePath, bool sdf, const std::string &cachePath)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(sourcePath.c_str(), &dataSize);
+    if (data == nullptr) return GetFontDefault();
+
+    Font font = {};
+    font.baseSize = sdf ? Constants::SDF_FONT_SIZE : Constants::FONT_SIZE;
+    font.glyphCount = Constants::FONT_GLYPH_COUNT;
+    font.glyphPadding = sdf ? 0 : Constants::FONT_GLYPH_PADDING;
+    font.glyphs =
+        LoadFontData(data, dataSize, font.baseSize, nullptr, font.glyphCount, sdf ? FONT_SDF : FONT_DEFAULT);
+    UnloadFileData(data);
+    if (font.glyphs == nullptr) return GetFontDefault();
+
+    int packMethod = sdf ? 1 : 0;
+    Image atlas =
+        GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, packMethod);
+    font.texture = LoadTextureFromImage(atlas);
+    if (!cachePath.empty()) {
+        FontAtlasCache::save(cachePath, sourcePath, font, atlas, sdf);
+    }
+    UnloadImage(atlas);
+    return font;
+}
+}  // namespace
 
 /**
  * @brief Font identifier for the main game font
@@ -28,10 +100,9 @@ const int FontManager::FONT_TITLE = 2;
 /**
  * @brief Default constructor
  *
- * Private constructor as part of the singleton pattern.
- * Fonts are not loaded here but in initFonts() to allow for proper resource management.
+ * Fonts are not loaded here but in initFonts(), which requires an open window.
  */
-FontManager::FontManager() {}
+FontManager::FontManager() : fonts(), sdf(false), sdfShader() {}
 
 /**
  * @brief Destructor
@@ -44,38 +115,74 @@ FontManager::~FontManager()
     for (auto &fontPair : fonts) {
         UnloadFont(fontPair.second);
     }
+    if (sdf) {
+        UnloadShader(sdfShader);
+    }
 }
 
 /**
- * @brief Gets the singleton instance of FontManager
+ * @brief Initializes and loads all game fonts
  *
- * @return FontManager& Reference to the singleton instance
+ * @param cacheDirectory Directory of the font atlas cache, or an empty string to always rasterize
+ * @param useSdf Whether to rasterize signed distance fields, drawn with getSdfShader()
  *
- * Implements the singleton pattern using local static initialization,
- * which is thread-safe in C++11 and later.
+ * Loads the following fonts from the assets directory:
+ * - Thaleah.ttf as the main font (FONT_MAIN)
+ * - Round.ttf as the title font (FONT_TITLE)
+ *
+ * Each font is loaded with the following parameters:
+ * - Font size: Constants::FONT_SIZE, or Constants::SDF_FONT_SIZE for distance fields
+ * - Glyphs of the first Constants::FONT_GLYPH_COUNT codepoints from 32 on
+ *
+ * The time it took and how many fonts came from the cache are logged, to compare cold
+ * and cached startups.
  */
-FontManager &FontManager::getInstance()
+void FontManager::initFonts(const std::string &cacheDirectory, bool useSdf)
 {
-    static FontManager instance;
-    return instance;
+    TraceScope trace("FontManager::initFonts", "asset");
+    auto start = std::chrono::steady_clock::now();
+
+    sdf = useSdf;
+    if (sdf) {
+        sdfShader = LoadShaderFromMemory(nullptr, SDF_FRAGMENT_SHADER);
+    }
+    int cached = 0;
+    cached += loadFont(FONT_MAIN, "Thaleah", cacheDirectory) ? 1 : 0;
+    cached += loadFont(FONT_TITLE, "Round", cacheDirectory) ? 1 : 0;
+
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TraceLog(LOG_INFO, "FONTS: Loaded %d fonts in %.1f ms, %d from the atlas cache%s", (int) fonts.size(), milliseconds,
+        cached, sdf ? " (SDF)" : "");
 }
 
 /**
- * @brief Initializes and loads all game fonts
- *
- * Loads the following fonts from the assets directory:
- * - Thaleah.ttf as the main font (FONT_MAIN)
- * - Round.ttf as the title font (FONT_TITLE)
+ * @brief Loads a font from the atlas cache, or rasterizes and caches it
  *
- * Each font is loaded with the following parameters:
- * - Font size: 256
- * - No specific chars to load (0)
- * - Maximum of 250 characters
+ * @param fontId Identifier to store the font under
+ * @param name File name of the TTF file in the fonts assets directory, without extension
+ * @param cacheDirectory Directory of the font atlas cache, or an empty string to always rasterize
+ * @return true if the font was loaded from the cache, false if it was rasterized
  */
-void FontManager::initFonts()
+bool FontManager::loadFont(int fontId, const char *name, const std::string &cacheDirectory)
 {
-    fonts[FONT_MAIN] = LoadFontEx(TextFormat("%sfonts/Thaleah.ttf", GameUtils::getAssetPath().c_str()), 256, 0, 250);
-    fonts[FONT_TITLE] = LoadFontEx(TextFormat("%sfonts/Round.ttf", GameUtils::getAssetPath().c_str()), 256, 0, 250);
+    std::string sourcePath = GameUtils::getAssetPath() + "fonts/" + name + ".ttf";
+    int fontSize = sdf ? Constants::SDF_FONT_SIZE : Constants::FONT_SIZE;
+    std::string cachePath;
+    if (!cacheDirectory.empty()) {
+        cachePath = cacheDirectory + "/" + name + "_" + std::to_string(fontSize) + (sdf ? "_sdf" : "") + ".esfa";
+    }
+
+    Font font;
+    bool cached = !cachePath.empty() &&
+                  FontAtlasCache::load(cachePath, sourcePath, fontSize, Constants::FONT_GLYPH_COUNT, sdf, font);
+    if (!cached) {
+        font = rasterizeFont(sourcePath, sdf, cachePath);
+    }
+    if (sdf) {
+        SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    fonts[fontId] = font;
+    return cached;
 }
 
 /**
@@ -95,3 +202,17 @@ Font FontManager::getFont(int fontId) const
     }
     return Font{};
 }
+
+/**
+ * @brief Checks whether the fonts are signed distance fields
+ *
+ * @return true if text has to be drawn with getSdfShader(), false for regular fonts
+ */
+bool FontManager::isSdf() const { return sdf; }
+
+/**
+ * @brief Gets the shader that draws signed distance field fonts
+ *
+ * @return Shader The shader, only loaded if isSdf() is true
+ */
+Shader FontManager::getSdfShader() const { return sdfShader; }
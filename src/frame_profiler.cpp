@@ -0,0 +1,197 @@
+/**
+ * @file frame_profiler.cpp
+ * @brief Implementation of the FrameProfiler class and its ScopedTimer
+ *
+ * The profiler sums up the time spent in each phase of a frame, measured by ScopedTimer
+ * objects around the phases, and the draw calls issued for the board, and keeps the sums
+ * of the last Constants::PROFILER_FRAME_COUNT frames in a ring buffer. A timer costs two
+ * clock reads and an addition, so the phases are always measured and the overlay only
+ * decides whether they are shown.
+ *
+ * The ring buffer has a single writer, the thread running the game, and publishes each
+ * completed frame by advancing an atomic frame counter, so readers never take a lock.
+ * The statistics reuse one preallocated buffer and do not allocate.
+ *
+ * While a trace is recorded, every ScopedTimer also becomes an event of the trace.
+ */
+
+#include "../include/frame_profiler.h"
+
+#include <algorithm>
+
+#include "../include/constants.h"
+#include "../include/tracing.h"
+
+/**
+ * @brief Constructor for the FrameProfiler class
+ *
+ * Allocates the ring buffer and the buffer the statistics are computed in.
+ */
+FrameProfiler::FrameProfiler()
+    : frames(Constants::PROFILER_FRAME_COUNT),
+      publishedFrames(0),
+      current(),
+      frameStart(),
+      frameStarted(false),
+      sortBuffer(Constants::PROFILER_FRAME_COUNT)
+{
+}
+
+/**
+ * @brief Completes the previous frame and starts measuring a new one
+ *
+ * The frame time of the completed frame is the time between both calls, so it includes
+ * everything the loop does besides the measured phases, e.g. waiting for vsync.
+ */
+void FrameProfiler::beginFrame()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (frameStarted) {
+        add(ProfilerPhase::FRAME, now - frameStart);
+        uint64_t frame = publishedFrames.load(std::memory_order_relaxed);
+        frames[frame % frames.size()] = current;
+        publishedFrames.store(frame + 1, std::memory_order_release);
+    }
+
+    current = FrameSample();
+    frameStart = now;
+    frameStarted = true;
+}
+
+/**
+ * @brief Adds time spent in a phase to the current frame
+ *
+ * @param phase Phase the time was spent in, a phase may be measured several times per frame
+ * @param elapsed Time spent
+ */
+void FrameProfiler::add(ProfilerPhase phase, std::chrono::steady_clock::duration elapsed)
+{
+    current.milliseconds[(int) phase] += std::chrono::duration<float, std::milli>(elapsed).count();
+}
+
+/**
+ * @brief Adds draw calls issued for the board to the current frame
+ */
+void FrameProfiler::addDrawCalls(int count) { current.drawCalls += count; }
+
+/**
+ * @brief Gets the number of completed frames in the ring buffer
+ */
+int FrameProfiler::getFrameCount() const
+{
+    return (int) std::min<uint64_t>(publishedFrames.load(std::memory_order_acquire), frames.size());
+}
+
+/**
+ * @brief Gets the time a completed frame spent in a phase
+ *
+ * @param phase Phase to get the time of
+ * @param age 0 for the last completed frame up to getFrameCount() - 1 for the oldest
+ * @return float Time in milliseconds
+ */
+float FrameProfiler::getMilliseconds(ProfilerPhase phase, int age) const
+{
+    uint64_t frame = publishedFrames.load(std::memory_order_acquire) - 1 - age;
+    return frames[frame % frames.size()].milliseconds[(int) phase];
+}
+
+/**
+ * @brief Computes the median, 99th percentile and maximum of a phase over the completed frames
+ *
+ * @return PhaseStats Times in milliseconds, all 0 before the first frame completed
+ */
+PhaseStats FrameProfiler::getStats(ProfilerPhase phase) const
+{
+    int count = getFrameCount();
+    for (int age = 0; age < count; age++) {
+        sortBuffer[age] = getMilliseconds(phase, age);
+    }
+    return getSortedStats(count);
+}
+
+/**
+ * @brief Gets the number of draw calls a completed frame issued for the board
+ *
+ * @param age 0 for the last completed frame up to getFrameCount() - 1 for the oldest
+ */
+int FrameProfiler::getDrawCalls(int age) const
+{
+    uint64_t frame = publishedFrames.load(std::memory_order_acquire) - 1 - age;
+    return frames[frame % frames.size()].drawCalls;
+}
+
+/**
+ * @brief Computes the median, 99th percentile and maximum of the board draw calls over the completed frames
+ */
+PhaseStats FrameProfiler::getDrawCallStats() const
+{
+    int count = getFrameCount();
+    for (int age = 0; age < count; age++) {
+        sortBuffer[age] = (float) getDrawCalls(age);
+    }
+    return getSortedStats(count);
+}
+
+/**
+ * @brief Sorts the first values of the statistics buffer and picks the median, 99th percentile and maximum
+ *
+ * @param count Number of values in the buffer
+ */
+PhaseStats FrameProfiler::getSortedStats(int count) const
+{
+    PhaseStats stats;
+    if (count == 0) return stats;
+
+    auto begin = sortBuffer.begin();
+    std::sort(begin, begin + count);
+    stats.p50 = sortBuffer[count / 2];
+    stats.p99 = sortBuffer[std::min(count - 1, count * 99 / 100)];
+    stats.max = sortBuffer[count - 1];
+    return stats;
+}
+
+/**
+ * @brief Gets the display name of a phase
+ */
+const char *FrameProfiler::getPhaseName(ProfilerPhase phase)
+{
+    switch (phase) {
+        case ProfilerPhase::FRAME:
+            return "frame";
+        case ProfilerPhase::TICK:
+            return "sim tick";
+        case ProfilerPhase::HANDLE_INPUT:
+            return "handleInput";
+        case ProfilerPhase::UPDATE:
+            return "update";
+        case ProfilerPhase::DRAW_GRID:
+            return "drawGrid";
+        case ProfilerPhase::DRAW_GAME_OBJECTS:
+            return "drawGameObjects";
+        case ProfilerPhase::DRAW_UI:
+            return "drawUI";
+        default:
+            return "";
+    }
+}
+
+/**
+ * @brief Starts measuring a phase until the timer goes out of scope
+ *
+ * @param profiler Profiler the time is added to
+ * @param phase Phase being measured
+ */
+ScopedTimer::ScopedTimer(FrameProfiler &profiler, ProfilerPhase phase)
+    : profiler(profiler), phase(phase), start(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * @brief Adds the time since construction to the phase and to a running trace
+ */
+ScopedTimer::~ScopedTimer()
+{
+    auto end = std::chrono::steady_clock::now();
+    profiler.add(phase, end - start);
+    Tracing::record(FrameProfiler::getPhaseName(phase), "frame", start, end);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file free_cell_index.cpp
+ * @brief Implementation of the FreeCellIndex class
+ *
+ * The index keeps every unoccupied grid cell in a dense array together with a
+ * cell-to-slot map. Occupying a cell swaps it with the last free cell and pops it,
+ * releasing appends it again. This makes occupy, release and drawing a uniformly
+ * random free cell constant-time operations, independent of the snake's length.
+ */
+
+#include "../include/free_cell_index.h"
+
+namespace
+{
+/**
+ * @brief Marker stored in the slot map for occupied cells
+ */
+constexpr int OCCUPIED = -1;
+}  // namespace
+
+/**
+ * @brief Constructs an index where all cells are free
+ *
+ * @param cellCount Number of cells on the grid
+ */
+FreeCellIndex::FreeCellIndex(int cellCount) : freeCells(cellCount), slots(cellCount) { reset(); }
+
+/**
+ * @brief Marks all cells as free again
+ */
+void FreeCellIndex::reset()
+{
+    freeCells.resize(slots.size());
+    for (int cell = 0; cell < (int) slots.size(); cell++) {
+        freeCells[cell] = cell;
+        slots[cell] = cell;
+    }
+}
+
+/**
+ * @brief Removes a cell from the free set
+ *
+ * @param cell Index of the cell to occupy, occupying an already occupied cell does nothing
+ */
+void FreeCellIndex::occupy(int cell)
+{
+    int slot = slots[cell];
+    if (slot == OCCUPIED) return;
+
+    int lastCell = freeCells.back();
+    freeCells[slot] = lastCell;
+    slots[lastCell] = slot;
+    freeCells.pop_back();
+    slots[cell] = OCCUPIED;
+}
+
+/**
+ * @brief Adds a cell back to the free set
+ *
+ * @param cell Index of the cell to release, releasing an already free cell does nothing
+ */
+void FreeCellIndex::release(int cell)
+{
+    if (slots[cell] != OCCUPIED) return;
+
+    slots[cell] = (int) freeCells.size();
+    freeCells.push_back(cell);
+}
+
+/**
+ * @brief Checks whether a cell is free
+ *
+ * @param cell Index of the cell to check
+ * @return true if the cell is not occupied, false otherwise
+ */
+bool FreeCellIndex::isFree(int cell) const { return slots[cell] != OCCUPIED; }
+
+/**
+ * @brief Gets the number of free cells
+ *
+ * @return int Number of cells that are currently free
+ */
+int FreeCellIndex::getFreeCount() const { return (int) freeCells.size(); }
+
+/**
+ * @brief Gets the number of cells on the grid
+ *
+ * @return int Total number of cells tracked by the index
+ */
+int FreeCellIndex::getCellCount() const { return (int) slots.size(); }
+
+/**
+ * @brief Draws a uniformly random free cell
+ *
+ * @param rng Random number generator to draw from
+ * @return int Index of a free cell, or -1 if the grid is completely occupied
+ */
+int FreeCellIndex::getRandomFreeCell(Random &rng) const
+{
+    if (freeCells.empty()) return -1;
+    return freeCells[rng.nextInt(0, (int) freeCells.size() - 1)];
+}
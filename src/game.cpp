@@ -5,62 +5,125 @@
  * This file contains the implementation of the main game loop, game state management,
  * input handling, and rendering logic for the Evil Snake game. The game features
  * multiple modes (normal, fast, and walls) and states (menu, playing, paused, etc.).
+ * The rules themselves live in SnakeSim; Game is the input and rendering shell on top.
+ *
+ * The window shows a view of at most the configured number of cells. On boards larger
+ * than the view, a camera follows the snake's head and only the visible cells are drawn.
+ *
+ * The simulation runs on a fixed timestep: every frame advances it by exactly as many
+ * ticks as fit into the elapsed time, and the snake is drawn interpolated between its
+ * previous and current cells, so rendering runs at the display rate independently.
+ *
+ * Games can be recorded into replay files and recorded games can be watched again:
+ * in replay mode the inputs come from the replay instead of the keyboard.
+ *
+ * The autopilot can be toggled at any time while playing. When enabled it chooses the
+ * direction of every tick and hands it to handleDirectionChange() like a key press.
+ *
+ * The background grid and the walls change rarely, so they are drawn into cached
+ * StaticLayer textures and copied to the screen with one draw call each per frame.
+ *
+ * With incremental rendering enabled in the config, the snake and the food are kept in
+ * a cached layer as well. Every tick marks the cells it changed, and only those are
+ * repainted before the next frame, so drawing the board no longer depends on the
+ * length of the snake. The snake then moves from cell to cell without interpolation.
+ *
+ * Every frame is measured phase by phase by a FrameProfiler, whose overlay can be
+ * toggled at any time to diagnose stutter.
+ *
+ * A Game owns no window and no global resources. It draws into the screen area of its
+ * ScreenManager and plays sounds through a shared SoundManager, so one process can host
+ * several games, e.g. side by side in one window.
  */
 
 #include "../include/game.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "../include/allocation_counter.h"
 #include "../include/constants.h"
-#include "../include/font_manager.h"
 #include "../include/game_utils.h"
-#include "../include/screen_manager.h"
-#include "../include/sound_manager.h"
+#include "../include/key_bindings.h"
+#include "../include/tracing.h"
 #include "raylib.h"
 
 /**
  * @brief Constructor for the Game class
  *
- * Initializes the game window, loads resources, and sets up initial game state.
- * The snake is placed at a random position and the first food item is spawned.
+ * @param screens Renderer of the game's UI, its bounds are the screen area of the game
+ * @param sounds Audio context shared by all games of the process
+ * @param config Board size, view size and rules of the game
+ * @param seed Seed used for every game, or std::nullopt to start each game with a fresh seed
+ * @param recordDirectory Directory to record every game into, or an empty string to not record
+ *
+ * Sets up the initial game state. The window and all resources must already exist.
+ * The simulation places the snake at a random position and spawns the first food item.
+ * The cell batch is sized for the view, including the partly visible cells at its edges,
+ * not for the whole board, since only cells inside the view are drawn.
  */
-Game::Game()
-    : state(GameState::MENU),
-      mode(GameMode::NORMAL),
-      score(0),
-      timeSinceLastMove(0.0f),
-      timeSinceLastEventCheck(0.0f),
+Game::Game(ScreenManager &screens, SoundManager &sounds, const GameConfig &config, std::optional<uint64_t> seed,
+    const std::string &recordDirectory)
+    : screens(screens),
+      sounds(sounds),
+      state(GameState::MENU),
+      sim(config, seed.value_or(Random::generateSeed())),
+      autopilot(sim.getGrid()),
+      autopilotEnabled(false),
+      fixedSeed(seed),
+      pendingDirection(Direction::NONE),
+      viewCellAmountX(std::min(config.viewCellAmountX, config.cellAmountX)),
+      viewCellAmountY(std::min(config.viewCellAmountY, config.cellAmountY)),
+      cameraX(0.0f),
+      cameraY(0.0f),
       startTime(0.0f),
       endTime(0.0f),
-      snake(GameUtils::getRandomGridPosition()),
-      wallPositions{}
+      tickAccumulator(0.0f),
+      recordDirectory(recordDirectory),
+      recorder(),
+      replay(std::nullopt),
+      replayPlayer(),
+      profiler(),
+      profilerVisible(false),
+      gridLayer(),
+      wallLayer(),
+      cellBatch(),
+      boardLayer(),
+      dirtyCells(),
+      modeText(),
+      timeText(),
+      frameAllocationCount(0),
+      allocationCheckState(GameState::MENU),
+      allocationCheckFrames(0)
 {
-    foodPosition = GameUtils::getRandomFoodPosition(snake.body, wallPositions);
-    InitWindow(Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT, "Evil Snake");
-    FontManager::getInstance().initFonts();
-    SoundManager::getInstance().initSounds();
-    GameUtils::applyApplicationIcon();
+    cellBatch.reserve((viewCellAmountX + 1) * (viewCellAmountY + 1) + 1);
+    dirtyCells.reserve(Constants::MAX_TICKS_PER_FRAME * 6);
 }
 
 /**
  * @brief Resets the game to its initial state
  *
  * Clears all game progress and returns to the menu state. This includes:
- * - Resetting score and timing information
- * - Clearing wall positions
- * - Resetting snake position and speed
- * - Generating new food position
+ * - Resetting timing information
+ * - Finishing the running recording and leaving replay mode
+ * - Resetting the simulation (score, walls, snake and food) with the fixed seed or a new one
+ * - Invalidating the cached layers of the board
  */
 void Game::reset()
 {
-    score = 0;
+    recorder.finish(sim);
+    replay.reset();
+    replayPlayer = ReplayPlayer();
     startTime = 0.0f;
     endTime = 0.0f;
+    tickAccumulator = 0.0f;
+    pendingDirection = Direction::NONE;
     state = GameState::MENU;
-    mode = GameMode::NORMAL;
-    wallPositions.clear();
-
-    snake.speed = Constants::DEFAULT_SNAKE_SPEED;
-    snake.resetToPosition(GameUtils::getRandomGridPosition());
-    foodPosition = GameUtils::getRandomFoodPosition(snake.body, wallPositions);
+    sim.reset(fixedSeed.value_or(Random::generateSeed()));
+    wallLayer.invalidate();
+    boardLayer.invalidate();
+    dirtyCells.clear();
 }
 
 /**
@@ -68,17 +131,23 @@ void Game::reset()
  *
  * Processes keyboard input based on the current game state, including:
  * - Screenshot functionality (available in all states)
+ * - Toggling the profiler overlay (available in all states)
  * - Game navigation (quit, pause, resume)
  * - Snake movement controls (WASD and arrow keys)
+ * - Toggling the autopilot
  * - Menu navigation
  */
 void Game::handleInput()
 {
     if (IsKeyPressed(Constants::KEY_SCREENSHOT)) {
-        SoundManager::getInstance().play(SoundManager::SOUND_CAMERA);
+        sounds.play(SoundManager::SOUND_CAMERA);
         GameUtils::takeScreenshot();
     }
 
+    if (IsKeyPressed(Constants::KEY_PROFILER)) {
+        profilerVisible = !profilerVisible;
+    }
+
     if (state == GameState::PLAYING || state == GameState::FINISHED || state == GameState::GAME_OVER ||
         state == GameState::PAUSED) {
         if (IsKeyPressed(Constants::KEY_QUIT)) {
@@ -99,21 +168,14 @@ void Game::handleInput()
         }
     }
 
-    if (state == GameState::PLAYING || state == GameState::MENU) {
-        std::unordered_map<int, Direction> keyMap = {
-            {KEY_UP, Direction::UP},
-            {KEY_W, Direction::UP},
-            {KEY_DOWN, Direction::DOWN},
-            {KEY_S, Direction::DOWN},
-            {KEY_LEFT, Direction::LEFT},
-            {KEY_A, Direction::LEFT},
-            {KEY_RIGHT, Direction::RIGHT},
-            {KEY_D, Direction::RIGHT},
-        };
-
-        for (const auto &[key, dir] : keyMap) {
-            if (IsKeyPressed(key)) {
-                handleDirectionChange(dir);
+    if ((state == GameState::PLAYING && !replay) || state == GameState::MENU) {
+        if (IsKeyPressed(Constants::KEY_AUTOPILOT)) {
+            toggleAutopilot();
+        }
+
+        for (const Constants::DirectionKey &binding : Constants::DIRECTION_KEYS) {
+            if (IsKeyPressed(binding.key)) {
+                handleDirectionChange(binding.direction);
             }
         }
     }
@@ -125,107 +187,395 @@ void Game::handleInput()
  * @param dir The new direction to set for the snake
  *
  * If called from the menu state, this also starts the game.
- * Otherwise, it updates the snake's direction during gameplay.
+ * Otherwise, it queues the direction for the next simulation tick.
  */
 void Game::handleDirectionChange(Direction dir)
 {
     if (state == GameState::MENU) {
-        SoundManager::getInstance().play(SoundManager::SOUND_START);
-        startTime = GetTime();
-        state = GameState::PLAYING;
+        startGame();
+    }
+    pendingDirection = dir;
+}
+
+/**
+ * @brief Switches the autopilot on or off
+ *
+ * Enabling the autopilot from the menu starts the game with the autopilot's first move.
+ */
+void Game::toggleAutopilot()
+{
+    autopilotEnabled = !autopilotEnabled;
+    if (autopilotEnabled) {
+        handleDirectionChange(autopilot.chooseDirection(sim));
     }
-    snake.setDirection(dir);
 }
 
 /**
- * @brief Changes the current game mode randomly
+ * @brief Starts playing the current game and, if enabled, starts recording it
+ */
+void Game::startGame()
+{
+    sounds.play(SoundManager::SOUND_START);
+    startTime = GetTime();
+    state = GameState::PLAYING;
+    if (!recordDirectory.empty() && !replay) {
+        recorder.open(GameUtils::getReplayFilePath(recordDirectory, sim.getSeed()), sim.getSeed(), sim.getConfig());
+    }
+}
+
+/**
+ * @brief Starts watching a recorded game
+ *
+ * @param recorded Replay to watch, its inputs replace the keyboard until the game is quit
+ *
+ * The board and rules are those the game was constructed with, so they should match
+ * the replay's configuration.
+ */
+void Game::startReplay(const Replay &recorded)
+{
+    reset();
+    replay = recorded;
+    replayPlayer = ReplayPlayer(*replay);
+    sim.reset(replay->seed);
+    wallLayer.invalidate();
+    boardLayer.invalidate();
+    startGame();
+}
+
+/**
+ * @brief Advances the simulation by one tick
  *
- * Switches between three possible modes:
- * - NORMAL: Default snake speed, no walls
- * - FAST: Increased snake speed, no walls
- * - WALLS: Default speed with randomly placed wall obstacles
+ * Lets the autopilot choose the direction if it is enabled, passes the queued direction,
+ * or the next recorded one in replay mode, to the simulation, records the direction the
+ * snake moved in and reacts to the events of the tick:
+ * - Playing sounds for eating, mode changes and collisions
+ * - Switching to the game over or victory state
+ * - Finishing the recording once the game has ended
  *
- * The mode change is accompanied by a sound effect and appropriate game modifications.
+ * With incremental rendering, the cells changed by the tick are marked for repainting.
  */
-void Game::changeGameMode()
+void Game::tick()
 {
-    static const std::vector<GameMode> gameModes = {GameMode::NORMAL, GameMode::FAST, GameMode::WALLS};
-    GameMode newMode = gameModes[GetRandomValue(0, (int) gameModes.size() - 1)];
+    ScopedTimer timer(profiler, ProfilerPhase::TICK);
+    if (autopilotEnabled && !replay) {
+        handleDirectionChange(autopilot.chooseDirection(sim));
+    }
 
-    if (mode == newMode) return;
+    markChangedCells();
+    StepResult result = sim.step(replay ? replayPlayer.next() : pendingDirection);
+    markChangedCells();
+    pendingDirection = Direction::NONE;
+    recorder.record(sim.getSnake().getDirection());
 
-    mode = newMode;
-    snake.speed = (mode == GameMode::FAST) ? Constants::FAST_SNAKE_SPEED : Constants::DEFAULT_SNAKE_SPEED;
-    wallPositions.clear();
+    if (result.modeChanged) {
+        sounds.play(SoundManager::SOUND_START);
+        wallLayer.invalidate();
+        boardLayer.invalidate();
+    }
 
-    if (mode == GameMode::WALLS) {
-        for (int i = 0; i < Constants::WALL_AMOUNT; i++) {
-            wallPositions.push_back(GameUtils::getRandomGridPosition());
-        }
+    if (result.ateFood) {
+        sounds.play(SoundManager::SOUND_EAT);
     }
 
-    SoundManager::getInstance().play(SoundManager::SOUND_START);
+    if (result.collided) {
+        sounds.play(SoundManager::SOUND_EXPLOSION);
+        endTime = GetTime();
+        state = GameState::GAME_OVER;
+    }
+
+    if (result.finished) {
+        endTime = GetTime();
+        state = GameState::FINISHED;
+    }
+
+    if (replay && replayPlayer.isFinished() && state == GameState::PLAYING) {
+        endTime = GetTime();
+        state = GameState::GAME_OVER;
+    }
+
+    if (state != GameState::PLAYING) {
+        recorder.finish(sim);
+    }
 }
 
 /**
  * @brief Updates the game state
  *
- * Handles game logic including:
- * - Checking for win condition
- * - Moving the snake
- * - Detecting collisions
- * - Managing food collection
- * - Triggering game mode changes
+ * Accumulates the frame time and runs one simulation tick for every full tick
+ * duration in the accumulator, keeping the remainder for the next frame. This keeps
+ * the tick rate independent of the frame rate, also across long frames. At most
+ * Constants::MAX_TICKS_PER_FRAME ticks run per frame, the rest of a very long stall
+ * is dropped instead of fast-forwarding the game.
  */
 void Game::update()
 {
-    if (score >= Constants::WINNING_SCORE) {
-        state = GameState::FINISHED;
-    }
-
     if (state != GameState::PLAYING) {
         return;
     }
 
-    timeSinceLastMove += GetFrameTime();
-    timeSinceLastEventCheck += GetFrameTime();
+    tickAccumulator += GetFrameTime();
+
+    int ticks = 0;
+    while (state == GameState::PLAYING && tickAccumulator >= sim.getTickDuration()) {
+        if (ticks == Constants::MAX_TICKS_PER_FRAME) {
+            tickAccumulator = 0.0f;
+            break;
+        }
+        tickAccumulator -= sim.getTickDuration();
+        tick();
+        ticks++;
+    }
+}
 
-    if (timeSinceLastEventCheck >= Constants::EVENT_INTERVAL) {
-        timeSinceLastEventCheck = 0.0f;
-        changeGameMode();
+/**
+ * @brief Gets how far the game is between the last and the next tick
+ *
+ * @return float 0 right after a tick up to 1 right before the next one, 1 outside of a running game
+ */
+float Game::getInterpolation() const
+{
+    if (state != GameState::PLAYING && state != GameState::PAUSED) {
+        return 1.0f;
     }
+    return std::clamp(tickAccumulator / sim.getTickDuration(), 0.0f, 1.0f);
+}
 
-    if (timeSinceLastMove >= snake.speed) {
-        timeSinceLastMove = 0.0f;
+/**
+ * @brief Interpolates a cell position between two ticks
+ *
+ * @param previous Cell before the last tick
+ * @param current Cell after the last tick
+ * @param alpha Interpolation factor from getInterpolation()
+ * @return Vector2 Position in cell units, snapped to the current cell when wrapping around the board
+ */
+Vector2 Game::getInterpolatedPosition(const Position &previous, const Position &current, float alpha) const
+{
+    int dx = current.x - previous.x;
+    int dy = current.y - previous.y;
+    if (std::abs(dx) > 1 || std::abs(dy) > 1) {
+        return {(float) current.x, (float) current.y};
+    }
+    return {previous.x + dx * alpha, previous.y + dy * alpha};
+}
 
-        if (snake.moveAndCheckForFood(foodPosition)) {
-            SoundManager::getInstance().play(SoundManager::SOUND_EAT);
-            score++;
-            foodPosition = GameUtils::getRandomFoodPosition(snake.body, wallPositions);
+/**
+ * @brief Moves the camera so that the snake's interpolated head stays centered
+ *
+ * @param alpha Interpolation factor from getInterpolation()
+ *
+ * Along an axis where the whole board fits into the view the camera stays at 0.
+ * Otherwise it wraps around the board just like the snake does.
+ */
+void Game::updateCamera(float alpha)
+{
+    const Grid &grid = sim.getGrid();
+    const Snake &snake = sim.getSnake();
+    Vector2 head = getInterpolatedPosition(snake.getPreviousPosition(0), snake.body.front(), alpha);
+
+    cameraX = 0.0f;
+    cameraY = 0.0f;
+    if (viewCellAmountX < grid.getWidth()) {
+        cameraX = std::fmod(head.x - viewCellAmountX / 2 + grid.getWidth(), (float) grid.getWidth());
+    }
+    if (viewCellAmountY < grid.getHeight()) {
+        cameraY = std::fmod(head.y - viewCellAmountY / 2 + grid.getHeight(), (float) grid.getHeight());
+    }
+}
+
+/**
+ * @brief Adds a single board cell to the cell batch if it is at least partly inside the view
+ *
+ * @param cell Position in cell units, may be fractional while interpolating
+ * @param color Fill color of the cell
+ */
+void Game::drawCell(Vector2 cell, Color color)
+{
+    const Grid &grid = sim.getGrid();
+    float x = cell.x - cameraX;
+    float y = cell.y - cameraY;
+    if (x <= -1.0f) x += grid.getWidth();
+    if (y <= -1.0f) y += grid.getHeight();
+    if (x > grid.getWidth() - 1) x -= grid.getWidth();
+    if (y > grid.getHeight() - 1) y -= grid.getHeight();
+    if (x >= viewCellAmountX || y >= viewCellAmountY) return;
+
+    float cellSize = sim.getConfig().cellSize;
+    Rectangle bounds = screens.getBounds();
+    cellBatch.add(Rectangle{bounds.x + x * cellSize, bounds.y + y * cellSize, cellSize, cellSize}, color);
+}
+
+/**
+ * @brief Adds a single board cell to the cell batch if it is inside the view
+ *
+ * @param position Cell position on the board, converted to pixels here
+ * @param color Fill color of the cell
+ */
+void Game::drawCell(const Position &position, Color color)
+{
+    drawCell(Vector2{(float) position.x, (float) position.y}, color);
+}
+
+/**
+ * @brief Marks the cells a tick can change for repainting, if incremental rendering is enabled
+ *
+ * Called before and after every tick. A tick only changes the cells of the head, the
+ * tail and the food, so marking them on both sides covers the new head, the previous
+ * head that turned into body, a vacated tail and the eaten and newly spawned food.
+ */
+void Game::markChangedCells()
+{
+    if (!sim.getConfig().incrementalRendering) return;
+
+    const Snake &snake = sim.getSnake();
+    dirtyCells.push_back(snake.body.front());
+    dirtyCells.push_back(snake.body.back());
+    dirtyCells.push_back(sim.getFoodPosition());
+}
+
+/**
+ * @brief Gets the color a cell has in the board layer
+ *
+ * @param position Cell on the board
+ * @return Color Red for the food, green for the head, dark green for the body and transparent otherwise
+ */
+Color Game::getCellColor(const Position &position) const
+{
+    if (position == sim.getFoodPosition()) return RED;
+    if (position == sim.getSnake().body.front()) return GREEN;
+    if (sim.isBlocked(position)) return DARKGREEN;
+    return BLANK;
+}
+
+/**
+ * @brief Redraws the cached layers of the board that are outdated
+ *
+ * - Grid layer: the background with light gray grid lines for the cells inside the view,
+ *   one texture pixel per screen pixel, redrawn when the view or cell size changes
+ * - Wall layer: the walls of the whole board, one texture pixel per cell, redrawn when
+ *   the walls change with the game mode or the game is reset
+ * - Board layer: only with incremental rendering, the snake and the food with one texture
+ *   pixel per cell, redrawn like the wall layer and otherwise updated in the cells that
+ *   were marked since the last frame
+ * - Menu layer of the screen manager, while the menu is shown
+ *
+ * Must be called outside of scissor mode.
+ */
+void Game::updateStaticLayers()
+{
+    float cellSize = sim.getConfig().cellSize;
+    int width = viewCellAmountX * cellSize;
+    int height = viewCellAmountY * cellSize;
+    if (gridLayer.needsRedraw(width, height)) {
+        gridLayer.beginRedraw(width, height);
+        DrawRectangle(0, 0, width, height, RAYWHITE);
+        for (int x = 0; x < viewCellAmountX; x++) {
+            DrawLine(x * cellSize, 0, x * cellSize, height, LIGHTGRAY);
         }
+        for (int y = 0; y < viewCellAmountY; y++) {
+            DrawLine(0, y * cellSize, width, y * cellSize, LIGHTGRAY);
+        }
+        gridLayer.endRedraw();
+    }
 
-        if (snake.hasCollided(wallPositions)) {
-            SoundManager::getInstance().play(SoundManager::SOUND_EXPLOSION);
-            endTime = GetTime();
-            state = GameState::GAME_OVER;
+    const Grid &grid = sim.getGrid();
+    if (wallLayer.needsRedraw(grid.getWidth(), grid.getHeight())) {
+        wallLayer.beginRedraw(grid.getWidth(), grid.getHeight());
+        for (const Position &wallPosition : sim.getWallPositions()) {
+            DrawRectangle(wallPosition.x, wallPosition.y, 1, 1, BLACK);
         }
+        wallLayer.endRedraw();
+    }
+
+    if (state == GameState::MENU) {
+        screens.prepareMenuScreen(sim.getConfig().winningScore);
     }
+
+    if (!sim.getConfig().incrementalRendering) return;
+
+    if (boardLayer.needsRedraw(grid.getWidth(), grid.getHeight())) {
+        boardLayer.beginRedraw(grid.getWidth(), grid.getHeight());
+        const Snake &snake = sim.getSnake();
+        for (int i = 0; i < snake.body.size(); i++) {
+            DrawRectangle(snake.body[i].x, snake.body[i].y, 1, 1, i == 0 ? GREEN : DARKGREEN);
+        }
+        const Position &food = sim.getFoodPosition();
+        DrawRectangle(food.x, food.y, 1, 1, RED);
+        boardLayer.endRedraw();
+    } else if (!dirtyCells.empty()) {
+        boardLayer.beginUpdate();
+        for (const Position &cell : dirtyCells) {
+            DrawRectangle(cell.x, cell.y, 1, 1, getCellColor(cell));
+        }
+        boardLayer.endUpdate();
+    }
+    dirtyCells.clear();
 }
 
 /**
  * @brief Draws the game grid
  *
- * Renders the background grid that serves as the game board.
- * The grid is drawn using light gray lines on a white background.
+ * Copies the cached grid layer into the screen area with a single draw call.
  */
 void Game::drawGrid()
 {
-    ClearBackground(RAYWHITE);
-    for (int x = 0; x < Constants::WINDOW_WIDTH; x += Constants::CELL_SIZE) {
-        DrawLine(x, 0, x, Constants::WINDOW_HEIGHT, LIGHTGRAY);
+    Rectangle bounds = screens.getBounds();
+    float cellSize = sim.getConfig().cellSize;
+    float width = (int) (viewCellAmountX * cellSize);
+    float height = (int) (viewCellAmountY * cellSize);
+    gridLayer.draw(Rectangle{0, 0, width, height}, Rectangle{bounds.x, bounds.y, width, height});
+    profiler.addDrawCalls(1);
+}
+
+/**
+ * @brief Draws the part of a layer with one pixel per cell that is inside the view
+ *
+ * @param layer Cached layer of the whole board, e.g. the walls
+ *
+ * The view shows the cells from the camera position onwards and wraps around the board
+ * edges, so it consists of up to four parts of the layer, each scaled from one pixel
+ * per cell up to the cell size.
+ */
+void Game::drawBoardLayer(const StaticLayer &layer)
+{
+    const Grid &grid = sim.getGrid();
+    float cellSize = sim.getConfig().cellSize;
+    Rectangle bounds = screens.getBounds();
+    float firstWidth = std::min((float) viewCellAmountX, grid.getWidth() - cameraX);
+    float firstHeight = std::min((float) viewCellAmountY, grid.getHeight() - cameraY);
+    float sourceX[2] = {cameraX, 0.0f};
+    float sourceY[2] = {cameraY, 0.0f};
+    float widths[2] = {firstWidth, viewCellAmountX - firstWidth};
+    float heights[2] = {firstHeight, viewCellAmountY - firstHeight};
+    float offsetsX[2] = {0.0f, firstWidth};
+    float offsetsY[2] = {0.0f, firstHeight};
+
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            if (widths[i] <= 0.0f || heights[j] <= 0.0f) continue;
+
+            Rectangle source = {sourceX[i], sourceY[j], widths[i], heights[j]};
+            Rectangle destination = {bounds.x + offsetsX[i] * cellSize, bounds.y + offsetsY[j] * cellSize,
+                widths[i] * cellSize, heights[j] * cellSize};
+            layer.draw(source, destination);
+            profiler.addDrawCalls(1);
+        }
     }
-    for (int y = 0; y < Constants::WINDOW_HEIGHT; y += Constants::CELL_SIZE) {
-        DrawLine(0, y, Constants::WINDOW_WIDTH, y, LIGHTGRAY);
+}
+
+/**
+ * @brief Draws the snake on the screen.
+ *
+ * @param alpha Interpolation factor from getInterpolation()
+ *
+ * Every segment is drawn between its previous and current cell.
+ * The snake's head is colored green, while the body is a darker green.
+ */
+void Game::drawSnake(float alpha)
+{
+    const Snake &snake = sim.getSnake();
+    for (int i = 0; i < snake.body.size(); ++i) {
+        Vector2 cell = getInterpolatedPosition(snake.getPreviousPosition(i), snake.body[i], alpha);
+        drawCell(cell, i == 0 ? GREEN : DARKGREEN);
     }
 }
 
@@ -234,15 +584,25 @@ void Game::drawGrid()
  *
  * Renders the main game elements:
  * - Food (red square)
- * - Snake (handled by Snake class)
- * - Walls (black squares, only in WALLS mode)
+ * - Snake
+ * - Walls (black squares, only in WALLS mode), from the cached wall layer
+ *
+ * The cells of the food and the snake are collected in the cell batch and submitted together,
+ * or with incremental rendering drawn from the cached board layer.
  */
 void Game::drawGameObjects()
 {
-    DrawRectangle(foodPosition.x, foodPosition.y, Constants::CELL_SIZE, Constants::CELL_SIZE, RED);
-    snake.draw();
-    for (const Vector2 &wallPosition : wallPositions) {
-        DrawRectangle(wallPosition.x, wallPosition.y, Constants::CELL_SIZE, Constants::CELL_SIZE, BLACK);
+    if (sim.getConfig().incrementalRendering) {
+        drawBoardLayer(boardLayer);
+    } else {
+        cellBatch.clear();
+        drawCell(sim.getFoodPosition(), RED);
+        drawSnake(getInterpolation());
+        profiler.addDrawCalls(cellBatch.submit());
+    }
+
+    if (!sim.getWallPositions().empty()) {
+        drawBoardLayer(wallLayer);
     }
 }
 
@@ -251,69 +611,158 @@ void Game::drawGameObjects()
  *
  * Renders the appropriate UI elements based on the current game state:
  * - Menu screen
- * - Playing screen (score, mode, time)
+ * - Playing screen (score, mode and whether the autopilot plays, time)
  * - Pause screen
  * - Game over screen
  * - Victory screen
+ * - Seed of the current game, on every screen
+ *
+ * The mode and time texts are formatted into members, which keep their memory between frames.
  */
 void Game::drawUI()
 {
+    int winningScore = sim.getConfig().winningScore;
     switch (state) {
         case GameState::MENU:
-            ScreenManager::getInstance().drawMenuScreen();
+            screens.drawMenuScreen(winningScore);
             break;
         case GameState::PLAYING:
-            ScreenManager::getInstance().drawPlayingScreen(
-                score, GameUtils::getFormattedGameMode(mode), GameUtils::getFormattedGameTime(startTime, GetTime()));
+            modeText = GameUtils::getFormattedGameMode(sim.getMode());
+            if (autopilotEnabled) {
+                modeText += " - Autopilot";
+            }
+            GameUtils::formatGameTime(startTime, GetTime(), timeText);
+            screens.drawPlayingScreen(sim.getScore(), winningScore, modeText, timeText);
             break;
         case GameState::PAUSED:
-            ScreenManager::getInstance().drawPauseScreen(score, GameUtils::getFormattedGameTime(startTime, endTime));
+            GameUtils::formatGameTime(startTime, endTime, timeText);
+            screens.drawPauseScreen(sim.getScore(), winningScore, timeText);
             break;
         case GameState::GAME_OVER:
-            ScreenManager::getInstance().drawGameOverScreen(score, GameUtils::getFormattedGameTime(startTime, endTime));
+            GameUtils::formatGameTime(startTime, endTime, timeText);
+            screens.drawGameOverScreen(sim.getScore(), winningScore, timeText);
             break;
         case GameState::FINISHED:
-            ScreenManager::getInstance().drawFinishedScreen(score, GameUtils::getFormattedGameTime(startTime, endTime));
+            GameUtils::formatGameTime(startTime, endTime, timeText);
+            screens.drawFinishedScreen(sim.getScore(), winningScore, timeText);
             break;
     }
+    screens.drawSeedInfo(sim.getSeed());
+}
+
+/**
+ * @brief Logs the previous frame if it allocated heap memory in a steady state
+ *
+ * Only active in builds that count allocations, see AllocationCounter. Changing the
+ * game state may allocate, e.g. to open a recording, so a frame is only checked once
+ * the game stayed in the same state for Constants::ALLOCATION_WARMUP_FRAMES frames.
+ * The frame loop is expected to not allocate at all from then on.
+ */
+void Game::checkFrameAllocations()
+{
+    if (!AllocationCounter::isEnabled()) return;
+
+    uint64_t count = AllocationCounter::getCount();
+    uint64_t allocations = count - frameAllocationCount;
+    frameAllocationCount = count;
+    if (state != allocationCheckState) {
+        allocationCheckState = state;
+        allocationCheckFrames = 0;
+        return;
+    }
+
+    if (++allocationCheckFrames > Constants::ALLOCATION_WARMUP_FRAMES && allocations > 0) {
+        TraceLog(LOG_WARNING, "Frame %d in state %d allocated %llu times", allocationCheckFrames, (int) state,
+            (unsigned long long) allocations);
+    }
 }
 
 /**
- * @brief Performs the complete draw cycle
+ * @brief Processes the input of the current frame and advances the game
+ *
+ * Hosts that run several games call this once per frame for every game. It also starts
+ * the next frame of the profiler, so the frame time spans from one call to the next,
+ * and checks the allocations of the previous frame.
+ */
+void Game::processFrame()
+{
+    profiler.beginFrame();
+    checkFrameAllocations();
+    {
+        ScopedTimer timer(profiler, ProfilerPhase::HANDLE_INPUT);
+        handleInput();
+    }
+    {
+        ScopedTimer timer(profiler, ProfilerPhase::UPDATE);
+        update();
+    }
+}
+
+/**
+ * @brief Draws the game into its screen area
  *
  * Handles all rendering operations in the correct order:
- * 1. Begin the drawing context
+ * 1. Move the camera, update the cached layers and clip drawing to the game's screen area
  * 2. Draw the background grid
  * 3. Draw game objects
  * 4. Draw UI elements
- * 5. End the drawing context
+ * 5. Draw the profiler overlay if it is enabled
+ *
+ * Must be called between BeginDrawing() and EndDrawing().
  */
 void Game::draw()
 {
-    BeginDrawing();
-    drawGrid();
-    drawGameObjects();
-    drawUI();
-    EndDrawing();
+    updateCamera(sim.getConfig().incrementalRendering ? 1.0f : getInterpolation());
+    updateStaticLayers();
+
+    Rectangle bounds = screens.getBounds();
+    BeginScissorMode(bounds.x, bounds.y, bounds.width, bounds.height);
+    {
+        ScopedTimer timer(profiler, ProfilerPhase::DRAW_GRID);
+        drawGrid();
+    }
+    {
+        ScopedTimer timer(profiler, ProfilerPhase::DRAW_GAME_OBJECTS);
+        drawGameObjects();
+    }
+    {
+        ScopedTimer timer(profiler, ProfilerPhase::DRAW_UI);
+        drawUI();
+    }
+    if (profilerVisible) {
+        screens.drawProfilerOverlay(profiler);
+    }
+    EndScissorMode();
 }
 
 /**
- * @brief Main game loop
+ * @brief Finishes a running recording, called when the game is shut down
+ */
+void Game::finish() { recorder.finish(sim); }
+
+/**
+ * @brief Main loop for a single game filling the window
  *
  * Runs the game until the window is closed:
  * 1. Process input
  * 2. Update game state
  * 3. Render frame
  *
- * Properly closes the window when the game ends.
+ * Finishes a running recording when the window is closed. The window itself
+ * belongs to the caller.
  */
 void Game::run()
 {
     while (!WindowShouldClose()) {
-        handleInput();
-        update();
+        TraceScope trace("Game::run frame", "frame");
+        processFrame();
+        BeginDrawing();
         draw();
+        {
+            TraceScope presentTrace("EndDrawing", "frame");
+            EndDrawing();
+        }
     }
 
-    CloseWindow();
+    finish();
 }
@@ -0,0 +1,303 @@
+/**
+ * @file game_config.cpp
+ * @brief Loading of the runtime game configuration
+ *
+ * The configuration (board and view size, cell size, winning score, speeds, wall
+ * amount, rendering mode and font type) starts with the defaults from Constants and can be overridden by a
+ * config file and by command line options. Config files contain one "key = value"
+ * pair per line, empty lines and lines starting with '#' are ignored. Every key can
+ * also be given on the command line as "--key value" with '_' replaced by '-'.
+ *
+ * Besides the configuration, the command line carries options of a single launch,
+ * such as the seed of the game.
+ */
+
+#include "../include/game_config.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace
+{
+/**
+ * @brief Removes leading and trailing whitespace
+ *
+ * @param text Text to trim
+ * @return std::string The trimmed text
+ */
+std::string trim(const std::string &text)
+{
+    size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(start, end - start + 1);
+}
+
+/**
+ * @brief Parses a complete string as a number
+ *
+ * @param value Text to parse
+ * @param result Parsed number, only written on success
+ * @return true if the whole text is a valid number, false otherwise
+ */
+template <typename T>
+bool parseNumber(const std::string &value, T &result)
+{
+    try {
+        size_t parsed = 0;
+        T number;
+        if constexpr (std::is_same_v<T, int>) {
+            number = std::stoi(value, &parsed);
+        } else {
+            number = std::stof(value, &parsed);
+        }
+        if (parsed != value.size()) {
+            return false;
+        }
+        result = number;
+        return true;
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+/**
+ * @brief Parses a switch given as "true"/"false" or "1"/"0"
+ *
+ * @param value Text to parse
+ * @param result Parsed switch, only written on success
+ * @return true if the text is one of the accepted values, false otherwise
+ */
+bool parseFlag(const std::string &value, bool &result)
+{
+    if (value == "true" || value == "1") {
+        result = true;
+        return true;
+    }
+    if (value == "false" || value == "0") {
+        result = false;
+        return true;
+    }
+    return false;
+}
+}  // namespace
+
+/**
+ * @brief Sets a single configuration value
+ *
+ * @param config Configuration to modify
+ * @param key Name of the setting, e.g. "board_width"
+ * @param value Textual value of the setting
+ * @return true if the key is known and the value could be parsed, false otherwise
+ */
+bool ConfigLoader::setValue(GameConfig &config, const std::string &key, const std::string &value)
+{
+    bool valid = false;
+    if (key == "board_width") {
+        valid = parseNumber(value, config.cellAmountX);
+    } else if (key == "board_height") {
+        valid = parseNumber(value, config.cellAmountY);
+    } else if (key == "view_width") {
+        valid = parseNumber(value, config.viewCellAmountX);
+    } else if (key == "view_height") {
+        valid = parseNumber(value, config.viewCellAmountY);
+    } else if (key == "cell_size") {
+        valid = parseNumber(value, config.cellSize);
+    } else if (key == "winning_score") {
+        valid = parseNumber(value, config.winningScore);
+    } else if (key == "default_speed") {
+        valid = parseNumber(value, config.defaultSnakeSpeed);
+    } else if (key == "fast_speed") {
+        valid = parseNumber(value, config.fastSnakeSpeed);
+    } else if (key == "event_interval") {
+        valid = parseNumber(value, config.eventInterval);
+    } else if (key == "wall_amount") {
+        valid = parseNumber(value, config.wallAmount);
+    } else if (key == "incremental_rendering") {
+        valid = parseFlag(value, config.incrementalRendering);
+    } else if (key == "sdf_fonts") {
+        valid = parseFlag(value, config.sdfFonts);
+    } else {
+        std::cerr << "Unknown config key: " << key << std::endl;
+        return false;
+    }
+
+    if (!valid) {
+        std::cerr << "Invalid value for " << key << ": " << value << std::endl;
+    }
+    return valid;
+}
+
+/**
+ * @brief Loads settings from a config file
+ *
+ * @param config Configuration to modify
+ * @param path Path of the config file
+ * @return true if the file could be read and all entries are valid, false otherwise
+ */
+bool ConfigLoader::loadFromFile(GameConfig &config, const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Could not open config file: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            std::cerr << path << ":" << lineNumber << ": expected key = value" << std::endl;
+            return false;
+        }
+
+        if (!setValue(config, trim(line.substr(0, separator)), trim(line.substr(separator + 1)))) {
+            std::cerr << path << ":" << lineNumber << ": invalid entry" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Loads settings and launch options from the command line
+ *
+ * Accepts "--config <path>" to load a config file, "--seed <number>" to replay a
+ * specific game, "--record <directory>" and "--replay <path>" for replay files,
+ * "--trace <path>" to record a performance trace and "--<key> <value>" for single
+ * settings. Options are applied in order, so later options override earlier ones.
+ *
+ * @param options Configuration and launch options to modify
+ * @param argc Number of arguments
+ * @param argv Argument values, argv[0] is the program name
+ * @return true if all arguments are valid, false otherwise
+ */
+bool ConfigLoader::loadFromArguments(LaunchOptions &options, int argc, char **argv)
+{
+    GameConfig &config = options.config;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return false;
+        }
+
+        if (std::strncmp(argv[i], "--", 2) != 0 || i + 1 >= argc) {
+            std::cerr << "Invalid argument: " << argv[i] << std::endl;
+            return false;
+        }
+
+        std::string key = argv[i] + 2;
+        std::string value = argv[++i];
+
+        if (key == "config") {
+            if (!loadFromFile(config, value)) return false;
+            continue;
+        }
+
+        if (key == "seed") {
+            try {
+                size_t parsed = 0;
+                options.seed = std::stoull(value, &parsed);
+                if (parsed != value.size()) throw std::invalid_argument(value);
+            } catch (const std::exception &) {
+                std::cerr << "Invalid seed: " << value << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        if (key == "record") {
+            options.recordDirectory = value;
+            continue;
+        }
+
+        if (key == "replay") {
+            options.replayPath = value;
+            continue;
+        }
+
+        if (key == "trace") {
+            options.tracePath = value;
+            continue;
+        }
+
+        std::replace(key.begin(), key.end(), '-', '_');
+        if (!setValue(config, key, value)) return false;
+    }
+
+    return validate(config);
+}
+
+/**
+ * @brief Checks that a configuration describes a playable game
+ *
+ * @param config Configuration to check
+ * @return true if all values are in range, false otherwise
+ */
+bool ConfigLoader::validate(const GameConfig &config)
+{
+    if (config.cellAmountX < 2 || config.cellAmountY < 2 || config.cellAmountX > Constants::MAX_CELL_AMOUNT ||
+        config.cellAmountY > Constants::MAX_CELL_AMOUNT) {
+        std::cerr << "Board size must be between 2 and " << Constants::MAX_CELL_AMOUNT << " cells" << std::endl;
+        return false;
+    }
+    if (config.viewCellAmountX < 1 || config.viewCellAmountY < 1) {
+        std::cerr << "View size must be at least one cell" << std::endl;
+        return false;
+    }
+    if (config.cellSize < 1.0f) {
+        std::cerr << "Cell size must be at least one pixel" << std::endl;
+        return false;
+    }
+    if (config.winningScore < 1 || config.wallAmount < 0) {
+        std::cerr << "Winning score must be positive and wall amount must not be negative" << std::endl;
+        return false;
+    }
+    if (config.defaultSnakeSpeed <= 0.0f || config.fastSnakeSpeed <= 0.0f || config.eventInterval <= 0.0f) {
+        std::cerr << "Speeds and event interval must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Prints the available command line options
+ *
+ * @param program Name of the executable
+ */
+void ConfigLoader::printUsage(const char *program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --config <path>          Load settings from a config file (key = value per line)\n"
+              << "  --seed <number>          Seed of the game, the same seed and inputs give the same game\n"
+              << "  --record <directory>     Record every game as a replay file into the directory\n"
+              << "  --replay <path>          Watch a recorded replay, its board and rules replace the settings\n"
+              << "  --trace <path>           Record a Chrome trace event file (chrome://tracing, Perfetto)\n"
+              << "  --board-width <cells>    Board width, up to " << Constants::MAX_CELL_AMOUNT << "\n"
+              << "  --board-height <cells>   Board height, up to " << Constants::MAX_CELL_AMOUNT << "\n"
+              << "  --view-width <cells>     Visible cells per row, the camera follows the snake\n"
+              << "  --view-height <cells>    Visible rows\n"
+              << "  --cell-size <pixels>     Size of a cell on screen\n"
+              << "  --winning-score <score>  Score needed to win\n"
+              << "  --default-speed <sec>    Seconds per move in normal and walls mode\n"
+              << "  --fast-speed <sec>       Seconds per move in fast mode\n"
+              << "  --event-interval <sec>   Seconds between random mode changes\n"
+              << "  --wall-amount <walls>    Number of walls in walls mode\n"
+              << "  --incremental-rendering <true|false>\n"
+              << "                           Repaint only the cells that changed on a tick, without smooth movement\n"
+              << "  --sdf-fonts <true|false>   Render text from smaller distance field font atlases\n";
+}
@@ -3,10 +3,9 @@
  * @brief Implementation of utility functions for the Evil Snake game
  *
  * This file provides various utility functions for game operations including:
- * - Random position generation
  * - Screenshot management
  * - Time formatting
- * - Asset path handling
+ * - Asset and cache path handling
  * - Game mode string formatting
  */
 
@@ -14,30 +13,17 @@
 
 #include <raylib.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <ctime>
 #include <filesystem>
-#include <format>
 #include <iostream>
 
-#include "../include/constants.h"
 #include "../include/game_mode.h"
+#include "../include/tracing.h"
 
 namespace
 {
-/**
- * @brief Checks if a position overlaps with any part of the snake
- *
- * @param position Position to check
- * @param snakePosition Vector of snake body positions
- * @return true if position overlaps with snake, false otherwise
- */
-bool isPositionOnSnake(Vector2 position, const std::vector<Vector2> &snakePosition)
-{
-    return std::find_if(snakePosition.begin(), snakePosition.end(), [&](const Vector2 &bodyPart) {
-        return bodyPart.x == position.x && bodyPart.y == position.y;
-    }) != snakePosition.end();
-}
-
 /**
  * @brief Gets the path to the game's resources directory
  *
@@ -76,6 +62,7 @@ std::string getResourcesPath()
  */
 void GameUtils::applyApplicationIcon()
 {
+    TraceScope trace("GameUtils::applyApplicationIcon", "asset");
     Image icon = LoadImage("assets/textures/EvilSnake.png");
     if (icon.width == 0 || icon.height == 0) {
         TraceLog(LOG_WARNING, "Failed to load application icon.");
@@ -94,6 +81,7 @@ void GameUtils::applyApplicationIcon()
  */
 void GameUtils::takeScreenshot()
 {
+    TraceScope trace("GameUtils::takeScreenshot", "screenshot");
     std::time_t now = std::time(nullptr);
     std::tm *localTime = std::localtime(&now);
     char timeBuffer[32];
@@ -116,6 +104,29 @@ void GameUtils::takeScreenshot()
     }
 }
 
+/**
+ * @brief Builds the path of a new replay file and creates its directory
+ *
+ * @param directory Directory the replays are recorded into
+ * @param seed Seed of the recorded game, part of the file name
+ * @return std::string Path of the form <directory>/Replay_<date>_<time>_<seed>.esr
+ */
+std::string GameUtils::getReplayFilePath(const std::string &directory, uint64_t seed)
+{
+    std::time_t now = std::time(nullptr);
+    std::tm *localTime = std::localtime(&now);
+    char timeBuffer[32];
+    std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d_%H-%M-%S", localTime);
+
+    try {
+        std::filesystem::create_directories(directory);
+    } catch (const std::filesystem::filesystem_error &e) {
+        std::cerr << "Filesystem error: " << e.what() << std::endl;
+    }
+    std::string filename = "Replay_" + std::string(timeBuffer) + "_" + std::to_string(seed) + ".esr";
+    return (std::filesystem::path(directory) / filename).string();
+}
+
 /**
  * @brief Opens the screenshots folder in the system's file explorer
  *
@@ -138,24 +149,27 @@ void GameUtils::openScreenshotsFolder()
  *
  * @param startTime The game start time in seconds
  * @param until The end time in seconds
- * @return std::string Formatted time string in "MM:SS:MS" format
+ * @param text Receives the time in "MM:SS:MS" format, reusing its memory, so formatting
+ *             the time every frame into the same string does not allocate
  */
-std::string GameUtils::getFormattedGameTime(float startTime, float until)
+void GameUtils::formatGameTime(float startTime, float until, std::string &text)
 {
     float elapsedTime = until - startTime;
     int minutes = (int) (elapsedTime) / 60;
     int seconds = (int) (elapsedTime) % 60;
     int milliseconds = (int) ((elapsedTime - (int) (elapsedTime)) * 100);
-    return std::format("{:02}:{:02}:{:02}", minutes, seconds, milliseconds);
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d", minutes, seconds, milliseconds);
+    text.assign(buffer, std::clamp(length, 0, (int) sizeof(buffer) - 1));
 }
 
 /**
  * @brief Converts a GameMode enum to its string representation
  *
  * @param mode The GameMode to convert
- * @return std::string String representation of the game mode
+ * @return const char* String representation of the game mode, a string literal
  */
-std::string GameUtils::getFormattedGameMode(GameMode mode)
+const char *GameUtils::getFormattedGameMode(GameMode mode)
 {
     switch (mode) {
         case GameMode::NORMAL:
@@ -170,64 +184,29 @@ std::string GameUtils::getFormattedGameMode(GameMode mode)
 }
 
 /**
- * @brief Generates a random position on the game grid
- *
- * @return Vector2 Random position aligned to the game grid
- */
-Vector2 GameUtils::getRandomGridPosition()
-{
-    int x = GetRandomValue(0, Constants::CELL_AMOUNT_X - 1) * Constants::CELL_SIZE;
-    int y = GetRandomValue(0, Constants::CELL_AMOUNT_Y - 1) * Constants::CELL_SIZE;
-    return {(float) (x), (float) (y)};
-}
-
-/**
- * @brief Generates a random position for food that doesn't overlap with snake or walls
+ * @brief Gets the path to the game's asset directory
  *
- * @param snakePosition Vector of current snake body positions
- * @param wallPositions Vector of current wall positions
- * @return Vector2 Valid random position for food
+ * @return std::string Path to the assets directory
  */
-Vector2 GameUtils::getRandomFoodPosition(
-    const std::vector<Vector2> &snakePosition, const std::vector<Vector2> &wallPositions)
+std::string GameUtils::getAssetPath()
 {
-    Vector2 position;
-    bool onSnake, onWall;
-
-    do {
-        position = getRandomGridPosition();
-        onSnake = isPositionOnSnake(position, snakePosition);
-        onWall = std::any_of(wallPositions.begin(), wallPositions.end(),
-            [&](const Vector2 &wall) { return position.x == wall.x && position.y == wall.y; });
-    } while (onSnake || onWall);
-
-    return position;
+    std::string resourcePath = getResourcesPath() + "/assets/";
+    return resourcePath;
 }
 
 /**
- * @brief Generates a random position for a wall that doesn't overlap with snake or food
+ * @brief Gets the path to the game's cache directory, e.g. for the font atlas cache
  *
- * @param snakePosition Vector of current snake body positions
- * @param foodPosition Current food position
- * @return Vector2 Valid random position for a wall
- */
-Vector2 GameUtils::getRandomWallPosition(const std::vector<Vector2> &snakePosition, const Vector2 &foodPosition)
-{
-    Vector2 position;
-    do {
-        position = getRandomGridPosition();
-    } while (
-        isPositionOnSnake(position, snakePosition) || (position.x == foodPosition.x && position.y == foodPosition.y));
-    return position;
-}
-
-/**
- * @brief Gets the path to the game's asset directory
+ * @return std::string Path of the cache directory, ending with a slash
  *
- * @return std::string Path to the assets directory
+ * On macOS the user's cache directory is used, since the app bundle must not change
+ * after it was signed. Otherwise the cache lives next to the assets.
  */
-std::string GameUtils::getAssetPath()
+std::string GameUtils::getCachePath()
 {
-    std::string resourcePath = getResourcesPath() + "/assets/";
-    return resourcePath;
+#ifdef MACOS_BUILD
+    return "/Users/" + std::string(getenv("USER")) + "/Library/Caches/EvilSnake/";
+#else
+    return getResourcesPath() + "/.cache/";
+#endif
 }
@@ -0,0 +1,64 @@
+/**
+ * @file grid.cpp
+ * @brief Implementation of the Grid class describing the board dimensions
+ *
+ * Positions are integer cell coordinates. Cells are numbered row-major from the top
+ * left corner of the board; the cell index is the key used by the occupancy bitboard
+ * and the free cell index. The board wraps around at its edges.
+ */
+
+#include "../include/grid.h"
+
+/**
+ * @brief Constructs a grid with the given board size
+ *
+ * @param width Number of cells per row
+ * @param height Number of rows
+ */
+Grid::Grid(int width, int height) : width(width), height(height) {}
+
+/**
+ * @brief Gets the number of cells per row
+ *
+ * @return int Board width in cells
+ */
+int Grid::getWidth() const { return width; }
+
+/**
+ * @brief Gets the number of rows
+ *
+ * @return int Board height in cells
+ */
+int Grid::getHeight() const { return height; }
+
+/**
+ * @brief Gets the number of cells on the board
+ *
+ * @return int Width times height
+ */
+int Grid::getCellCount() const { return width * height; }
+
+/**
+ * @brief Converts a cell position into its cell index
+ *
+ * @param position Cell coordinates on the board
+ * @return int Row-major index of the cell
+ */
+int Grid::getCellIndex(const Position &position) const { return position.y * width + position.x; }
+
+/**
+ * @brief Converts a cell index into its cell position
+ *
+ * @param cell Row-major index of the cell
+ * @return Position Cell coordinates on the board
+ */
+Position Grid::getCellPosition(int cell) const { return {(int16_t) (cell % width), (int16_t) (cell / width)}; }
+
+/**
+ * @brief Wraps coordinates that left the board back onto it
+ *
+ * @param x Column, may be one cell outside of the board
+ * @param y Row, may be one cell outside of the board
+ * @return Position The wrapped cell position
+ */
+Position Grid::wrap(int x, int y) const { return {(int16_t) ((x + width) % width), (int16_t) ((y + height) % height)}; }
@@ -3,23 +3,90 @@
  * @brief Entry point for the Evil Snake game
  *
  * This file contains the main function that initializes and runs
- * the game. It creates a Game instance and starts the main game loop.
+ * the game. It loads the configuration, opens the window, creates the
+ * shared resources and a Game instance and starts the main game loop,
+ * optionally watching a recorded replay.
  */
 
+#include <algorithm>
+#include <cstdio>
+
+#include "../include/font_manager.h"
 #include "../include/game.h"
+#include "../include/game_config.h"
+#include "../include/game_utils.h"
+#include "../include/replay.h"
+#include "../include/screen_manager.h"
+#include "../include/sound_manager.h"
+#include "../include/tracing.h"
+#include "raylib.h"
 
 /**
  * @brief Program entry point
  *
- * Creates a Game instance and runs the main game loop.
- * The game will continue running until the window is closed
- * or the user quits.
+ * Loads the game configuration from the command line, opens a window that fits
+ * the view, loads fonts and sounds, creates a Game instance and runs the main game
+ * loop. The game will continue running until the window is closed or the user quits.
+ * Fonts are loaded from the font atlas cache after the first launch.
+ * All resources are released before the window is closed.
+ *
+ * When a replay is given, its board, rules and seed replace the configured ones,
+ * only the view, cell size, rendering mode and font type are kept.
+ *
+ * With --trace, everything from opening the window until it is closed is recorded into
+ * a Chrome trace event file.
  *
- * @return int Returns 0 on successful execution
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments, see ConfigLoader::printUsage()
+ * @return int Returns 0 on successful execution, 1 on invalid arguments, an unreadable replay or trace file
  */
-int main()
+int main(int argc, char **argv)
 {
-    Game game;
-    game.run();
+    LaunchOptions options;
+    if (!ConfigLoader::loadFromArguments(options, argc, argv)) {
+        return 1;
+    }
+
+    Replay replay;
+    if (!options.replayPath.empty()) {
+        if (!ReplayUtils::load(options.replayPath, replay)) {
+            return 1;
+        }
+        replay.config.viewCellAmountX = options.config.viewCellAmountX;
+        replay.config.viewCellAmountY = options.config.viewCellAmountY;
+        replay.config.cellSize = options.config.cellSize;
+        replay.config.incrementalRendering = options.config.incrementalRendering;
+        replay.config.sdfFonts = options.config.sdfFonts;
+        options.config = replay.config;
+        options.seed = replay.seed;
+    }
+
+    if (!options.tracePath.empty() && !Tracing::start(options.tracePath)) {
+        std::fprintf(stderr, "Cannot write trace file %s\n", options.tracePath.c_str());
+        return 1;
+    }
+
+    const GameConfig &config = options.config;
+    float width = std::min(config.viewCellAmountX, config.cellAmountX) * config.cellSize;
+    float height = std::min(config.viewCellAmountY, config.cellAmountY) * config.cellSize;
+    InitWindow(width, height, "Evil Snake");
+    GameUtils::applyApplicationIcon();
+
+    {
+        FontManager fonts;
+        fonts.initFonts(GameUtils::getCachePath() + "fonts", config.sdfFonts);
+        SoundManager sounds;
+        sounds.initSounds();
+        ScreenManager screens(fonts, Rectangle{0, 0, width, height});
+
+        Game game(screens, sounds, config, options.seed, options.recordDirectory);
+        if (!options.replayPath.empty()) {
+            game.startReplay(replay);
+        }
+        game.run();
+    }
+
+    CloseWindow();
+    Tracing::stop();
     return 0;
 }
@@ -0,0 +1,322 @@
+/**
+ * @file mcts_bot.cpp
+ * @brief Implementation of the MctsBot class, a Monte Carlo tree search bot
+ *
+ * The bot runs playouts on copies of the headless simulation on all threads of its pool
+ * until a deadline and picks the move that was tried most often from the current state.
+ *
+ * The search is root-parallel: every thread grows its own tree, so the trees need no
+ * locks. Only the statistics of the moves from the current state are shared, as atomic
+ * counters on separate cache lines, and decide the chosen move over all threads.
+ *
+ * Food, walls and mode changes are random and unknown to the bot. Every playout therefore
+ * reseeds its copy of the game, which samples one possible future, and the trees are
+ * open-loop: a node stands for a sequence of moves, not for a board. Moves that lead into
+ * the surprise walls of the walls mode in many sampled futures get low values.
+ */
+
+#include "../include/mcts_bot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+/**
+ * @brief All directions the snake can move in
+ */
+constexpr Direction DIRECTIONS[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+
+/**
+ * @brief Maximum number of nodes of each thread's tree, playouts continue without expanding once it is full
+ */
+constexpr int MAX_TREE_NODES = 1 << 16;
+
+/**
+ * @brief Maximum number of random ticks after leaving the tree
+ */
+constexpr int ROLLOUT_DEPTH = 64;
+
+/**
+ * @brief Weight of exploring rarely tried moves against exploiting well rated ones
+ */
+constexpr float EXPLORATION = 1.4f;
+
+/**
+ * @brief Gets the slot of a direction in the children of a node and in the root statistics
+ */
+int getSlot(Direction dir) { return (int) dir - 1; }
+
+/**
+ * @brief Gets the direction pointing the other way
+ */
+Direction getOpposite(Direction dir)
+{
+    switch (dir) {
+        case Direction::UP:
+            return Direction::DOWN;
+        case Direction::DOWN:
+            return Direction::UP;
+        case Direction::LEFT:
+            return Direction::RIGHT;
+        case Direction::RIGHT:
+            return Direction::LEFT;
+        default:
+            return Direction::NONE;
+    }
+}
+
+/**
+ * @brief Gets the cell next to the head in a direction, wrapped around the board edges
+ */
+Position getNextHead(const SnakeSim &sim, Direction dir)
+{
+    Position head = sim.getSnake().body.front();
+    int x = head.x + (dir == Direction::RIGHT) - (dir == Direction::LEFT);
+    int y = head.y + (dir == Direction::DOWN) - (dir == Direction::UP);
+    return sim.getGrid().wrap(x, y);
+}
+
+/**
+ * @brief Gets the number of moves between two cells, taking the shorter way around the board edges
+ */
+int getWrappedDistance(const Grid &grid, const Position &from, const Position &to)
+{
+    int dx = std::abs(from.x - to.x);
+    int dy = std::abs(from.y - to.y);
+    return std::min(dx, grid.getWidth() - dx) + std::min(dy, grid.getHeight() - dy);
+}
+
+/**
+ * @brief Rates the end of a playout
+ *
+ * @param sim Game at the end of the playout
+ * @param startScore Score of the game the search started from
+ * @return float Value between 0 and 1, surviving counts as much as all food together
+ *
+ * Every eaten food item adds half the remaining food value, so short-term food never
+ * outweighs survival, and winning the game is worth the maximum.
+ */
+float getReward(const SnakeSim &sim, int startScore)
+{
+    if (sim.getStatus() == SimStatus::FINISHED) return 1.0f;
+
+    float foodValue = 1.0f - std::ldexp(1.0f, startScore - sim.getScore());
+    return (sim.getStatus() == SimStatus::RUNNING ? 0.5f : 0.0f) + 0.5f * foodValue;
+}
+}  // namespace
+
+/**
+ * @brief Constructor for the MctsBot class
+ *
+ * @param threadCount Number of threads running playouts, including the calling thread
+ * @param seed Seed for the futures the playouts sample, equal seeds give equal playouts per thread
+ *
+ * Starts the thread pool and allocates one tree and one scratch game per thread.
+ */
+MctsBot::MctsBot(int threadCount, uint64_t seed) : pool(threadCount), workers(pool.getThreadCount()), playoutCount(0)
+{
+    Random seeds(seed);
+    for (Worker &worker : workers) {
+        worker.rng.reseed(seeds.next());
+        worker.nodes.reserve(MAX_TREE_NODES);
+        worker.path.reserve(MAX_TREE_NODES);
+        worker.playouts = 0;
+    }
+}
+
+/**
+ * @brief Chooses a move within the duration of the game's current tick
+ *
+ * @param sim Game to play, it is not modified
+ * @return Direction Move for the next tick
+ */
+Direction MctsBot::chooseDirection(const SnakeSim &sim)
+{
+    return chooseDirection(sim, std::chrono::duration_cast<std::chrono::microseconds>(
+                                    std::chrono::duration<float>(sim.getTickDuration())));
+}
+
+/**
+ * @brief Chooses a move within a time budget
+ *
+ * @param sim Game to play, it is not modified
+ * @param budget Time the playouts may take, every thread runs at least one playout
+ * @return Direction Move tried most often over all threads, or the current direction if the game has ended
+ */
+Direction MctsBot::chooseDirection(const SnakeSim &sim, std::chrono::microseconds budget)
+{
+    Direction current = sim.getSnake().getDirection();
+    if (sim.getStatus() != SimStatus::RUNNING) return current;
+
+    auto deadline = std::chrono::steady_clock::now() + budget;
+    for (RootStats &stats : rootStats) {
+        stats.visits.store(0, std::memory_order_relaxed);
+        stats.reward.store(0.0, std::memory_order_relaxed);
+    }
+
+    pool.parallelFor(workers.size(), [&](size_t index, int) { search(workers[index], sim, deadline); });
+
+    playoutCount = 0;
+    for (const Worker &worker : workers) {
+        playoutCount += worker.playouts;
+    }
+
+    Direction best = current;
+    long bestVisits = 0;
+    for (Direction dir : DIRECTIONS) {
+        long visits = rootStats[getSlot(dir)].visits.load(std::memory_order_relaxed);
+        if (visits > bestVisits) {
+            bestVisits = visits;
+            best = dir;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Gets the number of playouts of the last chooseDirection() call over all threads
+ */
+long MctsBot::getPlayoutCount() const { return playoutCount; }
+
+/**
+ * @brief Gets the number of threads running playouts
+ */
+int MctsBot::getThreadCount() const { return pool.getThreadCount(); }
+
+/**
+ * @brief Grows one thread's tree from the current state until the deadline
+ */
+void MctsBot::search(Worker &worker, const SnakeSim &sim, std::chrono::steady_clock::time_point deadline)
+{
+    worker.nodes.clear();
+    addNode(worker);
+    worker.playouts = 0;
+    do {
+        runPlayout(worker, sim);
+        worker.playouts++;
+    } while (std::chrono::steady_clock::now() < deadline);
+}
+
+/**
+ * @brief Runs one playout in a freshly sampled future and updates the statistics along its moves
+ *
+ * Follows the best rated moves through the tree, adds the first untried move as a new
+ * node, plays on randomly from there and credits the result to every node on the way
+ * and to the shared statistics of the first move. A playout that cannot leave the root,
+ * because the tree is full before the root has a child, is dropped.
+ */
+void MctsBot::runPlayout(Worker &worker, const SnakeSim &sim)
+{
+    worker.scratch = sim;
+    worker.scratch.reseed(worker.rng.next());
+    worker.path.clear();
+
+    int node = 0;
+    Direction firstMove = Direction::NONE;
+    while (worker.scratch.getStatus() == SimStatus::RUNNING) {
+        Direction forbidden = getOpposite(worker.scratch.getSnake().getDirection());
+        Direction move = Direction::NONE;
+        for (Direction dir : DIRECTIONS) {
+            if (dir != forbidden && worker.nodes[node].children[getSlot(dir)] < 0) {
+                move = dir;
+                break;
+            }
+        }
+
+        bool expanding = move != Direction::NONE;
+        if (expanding && (int) worker.nodes.size() == MAX_TREE_NODES) break;
+        if (!expanding) move = selectChild(worker, node, forbidden);
+
+        worker.scratch.step(move);
+        if (node == 0) firstMove = move;
+        if (expanding) {
+            int child = addNode(worker);
+            worker.nodes[node].children[getSlot(move)] = child;
+            worker.path.push_back(child);
+            break;
+        }
+        node = worker.nodes[node].children[getSlot(move)];
+        worker.path.push_back(node);
+    }
+    if (firstMove == Direction::NONE) return;
+
+    rollout(worker);
+    float reward = getReward(worker.scratch, sim.getScore());
+    worker.nodes[0].visits++;
+    for (int visited : worker.path) {
+        worker.nodes[visited].visits++;
+        worker.nodes[visited].reward += reward;
+    }
+
+    RootStats &stats = rootStats[getSlot(firstMove)];
+    stats.visits.fetch_add(1, std::memory_order_relaxed);
+    stats.reward.fetch_add(reward, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Appends an unvisited node without children to a thread's tree
+ *
+ * @return int Index of the new node
+ */
+int MctsBot::addNode(Worker &worker)
+{
+    worker.nodes.push_back(Node{{-1, -1, -1, -1}, 0, 0.0f});
+    return (int) worker.nodes.size() - 1;
+}
+
+/**
+ * @brief Picks the child of a fully expanded node with the best upper confidence bound
+ *
+ * @param forbidden Reverse of the snake's direction, which is not a move
+ */
+Direction MctsBot::selectChild(const Worker &worker, int node, Direction forbidden) const
+{
+    float logVisits = std::log((float) worker.nodes[node].visits);
+    Direction best = Direction::NONE;
+    float bestValue = -1.0f;
+    for (Direction dir : DIRECTIONS) {
+        if (dir == forbidden) continue;
+
+        const Node &child = worker.nodes[worker.nodes[node].children[getSlot(dir)]];
+        float value = child.reward / child.visits + EXPLORATION * std::sqrt(logVisits / child.visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = dir;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Plays on from the end of the tree with random moves that do not collide right away
+ *
+ * Half of the moves head for the food if that is possible without colliding.
+ */
+void MctsBot::rollout(Worker &worker)
+{
+    SnakeSim &sim = worker.scratch;
+    for (int tick = 0; tick < ROLLOUT_DEPTH && sim.getStatus() == SimStatus::RUNNING; tick++) {
+        Direction forbidden = getOpposite(sim.getSnake().getDirection());
+        Direction options[4];
+        int optionCount = 0;
+        Direction towardsFood = Direction::NONE;
+        int foodDistance = getWrappedDistance(sim.getGrid(), sim.getSnake().body.front(), sim.getFoodPosition());
+        for (Direction dir : DIRECTIONS) {
+            Position next = getNextHead(sim, dir);
+            if (dir == forbidden || sim.isBlocked(next)) continue;
+
+            options[optionCount++] = dir;
+            if (getWrappedDistance(sim.getGrid(), next, sim.getFoodPosition()) < foodDistance) towardsFood = dir;
+        }
+
+        if (optionCount == 0) {
+            sim.step();
+        } else if (towardsFood != Direction::NONE && worker.rng.next() % 2 == 0) {
+            sim.step(towardsFood);
+        } else {
+            sim.step(options[worker.rng.nextInt(0, optionCount - 1)]);
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file random.cpp
+ * @brief Implementation of the Random class, a seedable xoshiro256** generator
+ *
+ * Every simulation owns its own generator, so runs are reproducible from their seed
+ * and many games can run concurrently without sharing global random state. The
+ * sequence only depends on the seed, not on the platform's standard library.
+ */
+
+#include "../include/random.h"
+
+#include <chrono>
+#include <random>
+
+namespace
+{
+/**
+ * @brief Advances a splitmix64 state and returns the next value
+ *
+ * Used to expand a single 64-bit seed into the 256-bit xoshiro state.
+ */
+uint64_t splitMix64(uint64_t &value)
+{
+    uint64_t result = (value += 0x9E3779B97F4A7C15ULL);
+    result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    result = (result ^ (result >> 27)) * 0x94D049BB133111EBULL;
+    return result ^ (result >> 31);
+}
+
+/**
+ * @brief Rotates a 64-bit value to the left
+ */
+uint64_t rotateLeft(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+}  // namespace
+
+/**
+ * @brief Constructs a generator from a seed
+ *
+ * @param seed Seed of the sequence, equal seeds produce equal sequences
+ */
+Random::Random(uint64_t seed) { reseed(seed); }
+
+/**
+ * @brief Creates a fresh seed from the system's entropy source and the clock
+ *
+ * @return uint64_t Seed for a new, non-reproducible run
+ */
+uint64_t Random::generateSeed()
+{
+    std::random_device device;
+    uint64_t seed = ((uint64_t) device() << 32) ^ device();
+    return seed ^ (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/**
+ * @brief Restarts the sequence from a new seed
+ *
+ * @param newSeed Seed of the sequence
+ */
+void Random::reseed(uint64_t newSeed)
+{
+    seed = newSeed;
+    uint64_t value = newSeed;
+    for (uint64_t &word : state) {
+        word = splitMix64(value);
+    }
+}
+
+/**
+ * @brief Gets the seed the current sequence was started with
+ *
+ * @return uint64_t The seed
+ */
+uint64_t Random::getSeed() const { return seed; }
+
+/**
+ * @brief Generates the next 64 random bits
+ *
+ * @return uint64_t Next value of the xoshiro256** sequence
+ */
+uint64_t Random::next()
+{
+    uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+    uint64_t shifted = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotateLeft(state[3], 45);
+
+    return result;
+}
+
+/**
+ * @brief Generates a uniformly distributed integer without modulo bias
+ *
+ * @param min Smallest value that may be returned
+ * @param max Largest value that may be returned
+ * @return int Random value in the inclusive range [min, max]
+ */
+int Random::nextInt(int min, int max)
+{
+    uint64_t range = (uint64_t) ((int64_t) max - min) + 1;
+    uint64_t limit = -range % range;
+    uint64_t value;
+    do {
+        value = next();
+    } while (value < limit);
+    return (int) (min + (int64_t) (value % range));
+}
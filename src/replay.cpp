@@ -0,0 +1,374 @@
+/**
+ * @file replay.cpp
+ * @brief Implementation of the compact binary replay format
+ *
+ * A replay stores the seed and rules of a game together with the direction the snake
+ * moved in on every tick. Since the simulation is deterministic, this is enough to
+ * reproduce the whole game. Directions take two bits and are run-length encoded as
+ * varints of (run length << 2 | direction), so long straight runs cost only a few bytes.
+ * A run length of zero marks the end of the inputs and is followed by the claimed outcome.
+ *
+ * Layout (all fixed-size values little endian):
+ *   magic "ESRP", u16 version, u64 seed,
+ *   i32 board width, i32 board height, i32 winning score, i32 wall amount,
+ *   f32 default speed, f32 fast speed, f32 event interval,
+ *   varint runs..., varint 0,
+ *   u64 ticks, i32 score, f32 elapsed time, u8 status
+ */
+
+#include "../include/replay.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <iterator>
+
+namespace
+{
+constexpr char MAGIC[4] = {'E', 'S', 'R', 'P'};
+constexpr uint16_t VERSION = 1;
+constexpr size_t WRITE_BUFFER_SIZE = 4096;
+
+/**
+ * @brief Appends an unsigned integer of the given byte width in little endian order
+ */
+void writeFixed(std::vector<uint8_t> &out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        out.push_back((uint8_t) (value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Appends a float by its bit pattern, so it is restored exactly
+ */
+void writeFloat(std::vector<uint8_t> &out, float value) { writeFixed(out, std::bit_cast<uint32_t>(value), 4); }
+
+/**
+ * @brief Appends an unsigned LEB128 varint
+ */
+void writeVarint(std::vector<uint8_t> &out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back((uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t) value);
+}
+
+/**
+ * @brief Appends the magic, version, seed and the rules that influence the simulation
+ *
+ * View and cell size only affect rendering and are left to the player.
+ */
+void writeHeader(std::vector<uint8_t> &out, uint64_t seed, const GameConfig &config)
+{
+    out.insert(out.end(), std::begin(MAGIC), std::end(MAGIC));
+    writeFixed(out, VERSION, 2);
+    writeFixed(out, seed, 8);
+    writeFixed(out, (uint32_t) config.cellAmountX, 4);
+    writeFixed(out, (uint32_t) config.cellAmountY, 4);
+    writeFixed(out, (uint32_t) config.winningScore, 4);
+    writeFixed(out, (uint32_t) config.wallAmount, 4);
+    writeFloat(out, config.defaultSnakeSpeed);
+    writeFloat(out, config.fastSnakeSpeed);
+    writeFloat(out, config.eventInterval);
+}
+
+/**
+ * @brief Appends a single direction run
+ */
+void writeRun(std::vector<uint8_t> &out, Direction direction, uint32_t length)
+{
+    writeVarint(out, ((uint64_t) length << 2) | (uint64_t) ((int) direction - 1));
+}
+
+/**
+ * @brief Appends the end marker and the outcome the recording claims
+ */
+void writeFooter(std::vector<uint8_t> &out, const ReplayOutcome &outcome)
+{
+    writeVarint(out, 0);
+    writeFixed(out, (uint64_t) outcome.ticks, 8);
+    writeFixed(out, (uint32_t) outcome.score, 4);
+    writeFloat(out, outcome.elapsedTime);
+    writeFixed(out, (uint8_t) outcome.status, 1);
+}
+
+/**
+ * @brief Bounds-checked cursor over the bytes of a replay
+ */
+struct Reader {
+    const std::vector<uint8_t> &data;
+    size_t offset = 0;
+    bool failed = false;
+
+    uint64_t readFixed(int bytes)
+    {
+        if (offset + bytes > data.size()) {
+            failed = true;
+            return 0;
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= (uint64_t) data[offset++] << (8 * i);
+        }
+        return value;
+    }
+
+    int32_t readInt() { return (int32_t) (uint32_t) readFixed(4); }
+
+    float readFloat() { return std::bit_cast<float>((uint32_t) readFixed(4)); }
+
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (offset >= data.size()) break;
+            uint8_t byte = data[offset++];
+            value |= (uint64_t) (byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        failed = true;
+        return 0;
+    }
+};
+}  // namespace
+
+/**
+ * @brief Constructor for the ReplayWriter class, no file is open until open() is called
+ */
+ReplayWriter::ReplayWriter() : runDirection(Direction::NONE), runLength(0) { buffer.reserve(WRITE_BUFFER_SIZE); }
+
+/**
+ * @brief Destructor, writes out whatever is still buffered
+ *
+ * A recording that was never finished has no end marker and fails to load.
+ */
+ReplayWriter::~ReplayWriter()
+{
+    if (file.is_open()) flushBuffer();
+}
+
+/**
+ * @brief Opens a new replay file and writes its header
+ *
+ * @param path File to create, an existing file is overwritten
+ * @param seed Seed of the recorded game
+ * @param config Rules of the recorded game
+ * @return true if the file could be opened
+ */
+bool ReplayWriter::open(const std::string &path, uint64_t seed, const GameConfig &config)
+{
+    if (file.is_open()) file.close();
+    buffer.clear();
+    runDirection = Direction::NONE;
+    runLength = 0;
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Could not create replay file: " << path << std::endl;
+        return false;
+    }
+    writeHeader(buffer, seed, config);
+    return true;
+}
+
+/**
+ * @brief Records the direction the snake moved in during one tick
+ *
+ * @param dir Effective direction after the tick, i.e. Snake::getDirection()
+ *
+ * Consecutive equal directions only extend the current run. Encoded runs are collected
+ * in memory and written to disk in blocks, so recording does no I/O on most ticks.
+ */
+void ReplayWriter::record(Direction dir)
+{
+    if (!file.is_open() || dir == Direction::NONE) return;
+
+    if (dir == runDirection && runLength < UINT32_MAX) {
+        runLength++;
+        return;
+    }
+    flushRun();
+    runDirection = dir;
+    runLength = 1;
+}
+
+/**
+ * @brief Finishes the recording with the outcome of the game and closes the file
+ *
+ * @param sim Simulation the inputs were recorded from
+ */
+void ReplayWriter::finish(const SnakeSim &sim)
+{
+    if (!file.is_open()) return;
+
+    flushRun();
+    writeFooter(buffer, ReplayUtils::getOutcome(sim));
+    flushBuffer();
+    file.close();
+}
+
+/**
+ * @brief Checks whether a recording is in progress
+ */
+bool ReplayWriter::isOpen() const { return file.is_open(); }
+
+/**
+ * @brief Encodes the current run into the buffer and writes the buffer once it is full
+ */
+void ReplayWriter::flushRun()
+{
+    if (runLength > 0) writeRun(buffer, runDirection, runLength);
+    runLength = 0;
+    if (buffer.size() >= WRITE_BUFFER_SIZE) flushBuffer();
+}
+
+/**
+ * @brief Writes all buffered bytes to the file
+ */
+void ReplayWriter::flushBuffer()
+{
+    file.write((const char *) buffer.data(), (std::streamsize) buffer.size());
+    buffer.clear();
+}
+
+/**
+ * @brief Constructs a player without inputs, it is finished immediately
+ */
+ReplayPlayer::ReplayPlayer() : runs(nullptr), runIndex(0), runPosition(0) {}
+
+/**
+ * @brief Constructs a player for the inputs of a replay
+ *
+ * @param replay Replay to play back, must outlive the player
+ */
+ReplayPlayer::ReplayPlayer(const Replay &replay) : runs(&replay.runs), runIndex(0), runPosition(0) {}
+
+/**
+ * @brief Returns the input of the next tick
+ *
+ * @return Direction Direction to step with, NONE once all inputs are used up
+ */
+Direction ReplayPlayer::next()
+{
+    if (isFinished()) return Direction::NONE;
+
+    const ReplayRun &run = (*runs)[runIndex];
+    if (++runPosition >= run.length) {
+        runIndex++;
+        runPosition = 0;
+    }
+    return run.direction;
+}
+
+/**
+ * @brief Checks whether all recorded inputs have been played
+ */
+bool ReplayPlayer::isFinished() const { return runs == nullptr || runIndex >= runs->size(); }
+
+/**
+ * @brief Reads and decodes a replay file
+ *
+ * @param path File to read
+ * @param replay Replay to fill
+ * @return true if the file exists and is a valid replay
+ */
+bool ReplayUtils::load(const std::string &path, Replay &replay)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Could not open replay file: " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!decode(data, replay)) {
+        std::cerr << "Invalid replay file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes a replay from its binary representation
+ *
+ * @param data Bytes of a replay file
+ * @param replay Replay to fill
+ * @return true if the data is a complete replay of a supported version with valid rules and no empty runs
+ */
+bool ReplayUtils::decode(const std::vector<uint8_t> &data, Replay &replay)
+{
+    Reader reader{data};
+    if (data.size() < sizeof(MAGIC) || !std::equal(std::begin(MAGIC), std::end(MAGIC), data.begin())) return false;
+    reader.offset = sizeof(MAGIC);
+    if (reader.readFixed(2) != VERSION) return false;
+
+    replay.seed = reader.readFixed(8);
+    replay.config = GameConfig{};
+    replay.config.cellAmountX = reader.readInt();
+    replay.config.cellAmountY = reader.readInt();
+    replay.config.winningScore = reader.readInt();
+    replay.config.wallAmount = reader.readInt();
+    replay.config.defaultSnakeSpeed = reader.readFloat();
+    replay.config.fastSnakeSpeed = reader.readFloat();
+    replay.config.eventInterval = reader.readFloat();
+    replay.config.viewCellAmountX = std::min(replay.config.cellAmountX, Constants::CELL_AMOUNT_X);
+    replay.config.viewCellAmountY = std::min(replay.config.cellAmountY, Constants::CELL_AMOUNT_Y);
+    if (reader.failed || !ConfigLoader::validate(replay.config)) return false;
+
+    replay.runs.clear();
+    for (uint64_t value = reader.readVarint(); value != 0 && !reader.failed; value = reader.readVarint()) {
+        if ((value >> 2) == 0 || (value >> 2) > UINT32_MAX) return false;
+        replay.runs.push_back({(Direction) ((value & 3) + 1), (uint32_t) (value >> 2)});
+    }
+
+    replay.outcome.ticks = (long) reader.readFixed(8);
+    replay.outcome.score = reader.readInt();
+    replay.outcome.elapsedTime = reader.readFloat();
+    uint64_t status = reader.readFixed(1);
+    replay.outcome.status = (SimStatus) status;
+    return !reader.failed && status <= (uint64_t) SimStatus::FINISHED;
+}
+
+/**
+ * @brief Encodes a complete replay into its binary representation
+ *
+ * @param replay Replay to encode
+ * @return std::vector<uint8_t> Bytes of the replay file, identical to what ReplayWriter produces
+ */
+std::vector<uint8_t> ReplayUtils::encode(const Replay &replay)
+{
+    std::vector<uint8_t> out;
+    writeHeader(out, replay.seed, replay.config);
+    for (const ReplayRun &run : replay.runs) {
+        writeRun(out, run.direction, run.length);
+    }
+    writeFooter(out, replay.outcome);
+    return out;
+}
+
+/**
+ * @brief Plays a replay back without rendering, as fast as the CPU allows
+ *
+ * @param replay Replay to play back
+ * @param maxTicks Number of ticks after which the playback stops even if inputs are left
+ * @return ReplayOutcome Outcome the inputs actually lead to, compare it to replay.outcome to verify a claim
+ */
+ReplayOutcome ReplayUtils::simulate(const Replay &replay, long maxTicks)
+{
+    SnakeSim sim(replay.config, replay.seed);
+    ReplayPlayer player(replay);
+    while (!player.isFinished() && sim.getStatus() == SimStatus::RUNNING && sim.getTicks() < maxTicks) {
+        sim.step(player.next());
+    }
+    return getOutcome(sim);
+}
+
+/**
+ * @brief Collects the current outcome of a simulation
+ */
+ReplayOutcome ReplayUtils::getOutcome(const SnakeSim &sim)
+{
+    return ReplayOutcome{sim.getTicks(), sim.getScore(), sim.getElapsedTime(), sim.getStatus()};
+}
@@ -1,79 +1,244 @@
 /**
  * @file screen_manager.cpp
- * @brief Implementation of the ScreenManager singleton class
+ * @brief Implementation of the ScreenManager class
  *
  * This file implements a screen manager that handles the rendering of different
  * game screens (menu, playing, pause, game over, and finished states). It manages
  * the layout and positioning of UI elements using aligned text rendering.
+ * Every game has its own ScreenManager that lays the UI out inside the game's
+ * screen area, while the fonts are shared.
+ *
+ * The UI is retained between frames: measured text sizes are cached, texts built from
+ * the score, mode, time or seed are only rebuilt when that value changes, and the static
+ * labels of the menu are drawn once into a cached layer that is copied to the screen with
+ * a single draw call.
  */
 
 #include "../include/screen_manager.h"
 
-#include "../include/font_manager.h"
-#include "../include/text_utils.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+/**
+ * @brief Size of the score text buffer, fits "Score: " and two full 32 bit numbers
+ */
+constexpr int SCORE_TEXT_CAPACITY = 32;
+}  // namespace
 
 /**
- * @brief Default constructor
+ * @brief Constructor for the ScreenManager class
  *
- * Private constructor as part of the singleton pattern.
+ * @param fonts Loaded fonts, must outlive the screen manager
+ * @param bounds Screen area of the game the UI is drawn in
  */
-ScreenManager::ScreenManager() {}
+ScreenManager::ScreenManager(const FontManager &fonts, Rectangle bounds)
+    : fonts(fonts),
+      bounds(bounds),
+      textCache(),
+      menuLayer(),
+      menuWinningScore(0),
+      shownScore(-1),
+      shownWinningScore(-1),
+      shownSeed(0),
+      scoreText(),
+      seedText(),
+      modeLabel(),
+      timeLabel()
+{
+    scoreText.reserve(SCORE_TEXT_CAPACITY);
+}
 
 /**
- * @brief Destructor
+ * @brief Gets the screen area the UI is drawn in
+ */
+Rectangle ScreenManager::getBounds() const { return bounds; }
+
+/**
+ * @brief Moves or resizes the screen area the UI is drawn in
+ *
+ * @param newBounds New screen area of the game
  */
-ScreenManager::~ScreenManager() {}
+void ScreenManager::setBounds(Rectangle newBounds) { bounds = newBounds; }
 
 /**
- * @brief Gets the singleton instance of ScreenManager
+ * @brief Draws a text aligned inside the screen area in the UI color
  *
- * @return ScreenManager& Reference to the singleton instance
+ * @param text The text string to render
+ * @param fontId The identifier of the font to use
+ * @param fontSize The font size to render the text
+ * @param verticalAlignment The vertical alignment of the text
+ * @param horizontalAlignment The horizontal alignment of the text
+ * @param padding Additional padding from the aligned edge
+ */
+void ScreenManager::drawText(const char *text, int fontId, float fontSize, VerticalAlignment verticalAlignment,
+    HorizontalAlignment horizontalAlignment, float padding)
+{
+    drawText(bounds, text, fontId, fontSize, verticalAlignment, horizontalAlignment, padding);
+}
+
+/**
+ * @brief Draws a text aligned inside an area in the UI color, with its size from the text cache
  *
- * Implements the singleton pattern using local static initialization,
- * which is thread-safe in C++11 and later.
+ * @param area The area the text is aligned in, e.g. the screen area or a cached layer
+ * @param text The text string to render
+ * @param fontId The identifier of the font to use
+ * @param fontSize The font size to render the text
+ * @param verticalAlignment The vertical alignment of the text
+ * @param horizontalAlignment The horizontal alignment of the text
+ * @param padding Additional padding from the aligned edge
  */
-ScreenManager &ScreenManager::getInstance()
+void ScreenManager::drawText(Rectangle area, const char *text, int fontId, float fontSize,
+    VerticalAlignment verticalAlignment, HorizontalAlignment horizontalAlignment, float padding)
 {
-    static ScreenManager instance;
-    return instance;
+    Font font = fonts.getFont(fontId);
+    Vector2 textSize = textCache.measure(font, text, fontSize);
+    beginText();
+    TextUtils::drawMeasuredText(
+        text, font, textSize, area, fontSize, DARKGRAY, verticalAlignment, horizontalAlignment, padding);
+    endText();
+}
+
+/**
+ * @brief Prepares drawing text, enabling the distance field shader if the fonts need it
+ */
+void ScreenManager::beginText() const
+{
+    if (fonts.isSdf()) {
+        BeginShaderMode(fonts.getSdfShader());
+    }
+}
+
+/**
+ * @brief Finishes drawing text started with beginText()
+ */
+void ScreenManager::endText() const
+{
+    if (fonts.isSdf()) {
+        EndShaderMode();
+    }
+}
+
+/**
+ * @brief Gets the score text, rebuilding it only when the score changed
+ *
+ * @param score Current game score
+ * @param winningScore Score needed to win the game
+ * @return const char* "Score: <score>/<winningScore>", valid until the next call
+ *
+ * The text is formatted into the retained string, whose memory is reserved for the
+ * longest possible score text, so a changing score never allocates.
+ */
+const char *ScreenManager::getScoreText(int score, int winningScore)
+{
+    if (score != shownScore || winningScore != shownWinningScore) {
+        shownScore = score;
+        shownWinningScore = winningScore;
+        char buffer[SCORE_TEXT_CAPACITY];
+        int length = std::snprintf(buffer, sizeof(buffer), "Score: %d/%d", score, winningScore);
+        scoreText.assign(buffer, std::clamp(length, 0, (int) sizeof(buffer) - 1));
+    }
+    return scoreText.c_str();
+}
+
+/**
+ * @brief Gets the text of a label, rebuilding it only when its value changed
+ *
+ * @param label Retained label, always used with the same prefix
+ * @param prefix Text in front of the value, e.g. "Time: "
+ * @param value Current value of the label
+ * @return const char* The prefix followed by the value, valid until the label changes
+ */
+const char *ScreenManager::getLabelText(RetainedLabel &label, const char *prefix, const std::string &value)
+{
+    if (!label.valid || label.value != value) {
+        label.value = value;
+        label.text = prefix;
+        label.text += value;
+        label.valid = true;
+    }
+    return label.text.c_str();
+}
+
+/**
+ * @brief Draws the labels of the main menu
+ *
+ * @param area Area the labels are aligned in
+ * @param winningScore Score needed to win the game
+ */
+void ScreenManager::drawMenuLabels(Rectangle area, int winningScore)
+{
+    drawText(area, "EVILSNAKE", FontManager::FONT_TITLE, 80, VerticalAlignment::TOP, HorizontalAlignment::CENTER, 60);
+    drawText(area, "Press the [ARROW KEYS / WASD] to start and play the game", FontManager::FONT_MAIN, 25,
+        VerticalAlignment::TOP, HorizontalAlignment::CENTER, 180);
+    drawText(area, ("You have to reach a score of " + std::to_string(winningScore)).c_str(), FontManager::FONT_MAIN,
+        20, VerticalAlignment::TOP, HorizontalAlignment::CENTER, 220);
+    drawText(area, "Made by Florian", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM, HorizontalAlignment::LEFT,
+        10);
+    drawText(
+        area, "[ESC] - Quit", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM, HorizontalAlignment::CENTER, 10);
+    drawText(area, "[L] - Screenshot / [O] Open Screenshots", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM,
+        HorizontalAlignment::CENTER, 30);
+    drawText(area, "[P] - Autopilot", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM,
+        HorizontalAlignment::CENTER, 50);
+    drawText(area, "v1.0.0", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM, HorizontalAlignment::RIGHT, 10);
+}
+
+/**
+ * @brief Draws the main menu into its cached layer if the layer is outdated
+ *
+ * @param winningScore Score needed to win the game
+ *
+ * The layer is redrawn when the size of the screen area or the winning score changed.
+ * Must be called outside of scissor mode, before drawMenuScreen().
+ */
+void ScreenManager::prepareMenuScreen(int winningScore)
+{
+    int width = (int) bounds.width;
+    int height = (int) bounds.height;
+    if (!menuLayer.needsRedraw(width, height) && winningScore == menuWinningScore) return;
+
+    menuLayer.beginRedraw(width, height);
+    drawMenuLabels(Rectangle{0, 0, (float) width, (float) height}, winningScore);
+    menuLayer.endRedraw();
+    menuWinningScore = winningScore;
 }
 
 /**
  * @brief Renders the main menu screen
  *
+ * @param winningScore Score needed to win the game
+ *
  * Displays:
  * - Game title
  * - Control instructions
  * - Game objective
  * - Credits
  * - Version information
- * - Available commands (screenshots, quit)
+ * - Available commands (screenshots, autopilot, quit)
  *
  * All text elements are positioned using alignment-based positioning
- * for consistent layout across different screen sizes.
+ * for consistent layout across different screen sizes. After prepareMenuScreen() they
+ * are copied from the cached menu layer, otherwise they are drawn directly.
  */
-void ScreenManager::drawMenuScreen()
+void ScreenManager::drawMenuScreen(int winningScore)
 {
-    TextUtils::drawAlignedText(
-        "EVILSNAKE", FontManager::FONT_TITLE, 80, DARKGRAY, VerticalAlignment::TOP, HorizontalAlignment::CENTER, 60);
-    TextUtils::drawAlignedText("Press the [ARROW KEYS / WASD] to start and play the game", FontManager::FONT_MAIN, 25,
-        DARKGRAY, VerticalAlignment::TOP, HorizontalAlignment::CENTER, 180);
-    TextUtils::drawAlignedText("You have to reach a score of 100", FontManager::FONT_MAIN, 20, DARKGRAY,
-        VerticalAlignment::TOP, HorizontalAlignment::CENTER, 220);
-    TextUtils::drawAlignedText("Made by Florian", FontManager::FONT_MAIN, 20, DARKGRAY, VerticalAlignment::BOTTOM,
-        HorizontalAlignment::LEFT, 10);
-    TextUtils::drawAlignedText("[ESC] - Quit", FontManager::FONT_MAIN, 20, DARKGRAY, VerticalAlignment::BOTTOM,
-        HorizontalAlignment::CENTER, 10);
-    TextUtils::drawAlignedText("[L] - Screenshot / [O] Open Screenshots", FontManager::FONT_MAIN, 20, DARKGRAY,
-        VerticalAlignment::BOTTOM, HorizontalAlignment::CENTER, 30);
-    TextUtils::drawAlignedText(
-        "v1.0.0", FontManager::FONT_MAIN, 20, DARKGRAY, VerticalAlignment::BOTTOM, HorizontalAlignment::RIGHT, 10);
+    int width = (int) bounds.width;
+    int height = (int) bounds.height;
+    if (menuLayer.needsRedraw(width, height) || winningScore != menuWinningScore) {
+        drawMenuLabels(bounds, winningScore);
+        return;
+    }
+    Rectangle layerArea = {0, 0, (float) width, (float) height};
+    menuLayer.draw(layerArea, Rectangle{bounds.x, bounds.y, layerArea.width, layerArea.height});
 }
 
 /**
  * @brief Renders the playing screen with game information
  *
  * @param score Current game score
+ * @param winningScore Score needed to win the game
  * @param gameMode Current game mode string
  * @param time Formatted game time string
  *
@@ -81,26 +246,27 @@ void ScreenManager::drawMenuScreen()
  * - Current score
  * - Game mode
  * - Elapsed time
- * - Available commands (quit, pause)
+ * - Available commands (quit, pause, autopilot)
  */
-void ScreenManager::drawPlayingScreen(int score, std::string gameMode, std::string time)
+void ScreenManager::drawPlayingScreen(int score, int winningScore, const std::string &gameMode, const std::string &time)
 {
-    TextUtils::drawAlignedText(("Score: " + std::to_string(score) + "/100").c_str(), FontManager::FONT_MAIN, 30,
-        DARKGRAY, VerticalAlignment::TOP, HorizontalAlignment::RIGHT, 10);
-    TextUtils::drawAlignedText(("Mode: " + gameMode).c_str(), FontManager::FONT_MAIN, 30, DARKGRAY,
-        VerticalAlignment::TOP, HorizontalAlignment::CENTER, 10);
-    TextUtils::drawAlignedText(("Time: " + time).c_str(), FontManager::FONT_MAIN, 30, DARKGRAY, VerticalAlignment::TOP,
+    drawText(getScoreText(score, winningScore), FontManager::FONT_MAIN, 30, VerticalAlignment::TOP,
+        HorizontalAlignment::RIGHT, 10);
+    drawText(getLabelText(modeLabel, "Mode: ", gameMode), FontManager::FONT_MAIN, 30, VerticalAlignment::TOP,
+        HorizontalAlignment::CENTER, 10);
+    drawText(getLabelText(timeLabel, "Time: ", time), FontManager::FONT_MAIN, 30, VerticalAlignment::TOP,
         HorizontalAlignment::LEFT, 10);
-    TextUtils::drawAlignedText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 20, DARKGRAY,
-        VerticalAlignment::BOTTOM, HorizontalAlignment::CENTER, 10);
-    TextUtils::drawAlignedText("[J] - Pause", FontManager::FONT_MAIN, 20, DARKGRAY, VerticalAlignment::BOTTOM,
-        HorizontalAlignment::CENTER, 30);
+    drawText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM,
+        HorizontalAlignment::CENTER, 10);
+    drawText("[J] - Pause", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM, HorizontalAlignment::CENTER, 30);
+    drawText("[P] - Autopilot", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM, HorizontalAlignment::CENTER, 50);
 }
 
 /**
  * @brief Renders the pause screen
  *
  * @param score Current game score
+ * @param winningScore Score needed to win the game
  * @param time Formatted game time string
  *
  * Displays:
@@ -109,24 +275,23 @@ void ScreenManager::drawPlayingScreen(int score, std::string gameMode, std::stri
  * - Elapsed time
  * - Available commands (quit, continue)
  */
-void ScreenManager::drawPauseScreen(int score, std::string time)
-{
-    TextUtils::drawAlignedText(
-        "Pause", FontManager::FONT_MAIN, 60, DARKGRAY, VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -120);
-    TextUtils::drawAlignedText(("Score: " + std::to_string(score) + "/100").c_str(), FontManager::FONT_MAIN, 30,
-        DARKGRAY, VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -50);
-    TextUtils::drawAlignedText(("Time: " + time).c_str(), FontManager::FONT_MAIN, 30, DARKGRAY,
-        VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -70);
-    TextUtils::drawAlignedText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 20, DARKGRAY,
-        VerticalAlignment::BOTTOM, HorizontalAlignment::CENTER, 10);
-    TextUtils::drawAlignedText("[J] - Continue", FontManager::FONT_MAIN, 20, DARKGRAY, VerticalAlignment::BOTTOM,
-        HorizontalAlignment::CENTER, 30);
+void ScreenManager::drawPauseScreen(int score, int winningScore, const std::string &time)
+{
+    drawText("Pause", FontManager::FONT_MAIN, 60, VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -120);
+    drawText(getScoreText(score, winningScore), FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, -50);
+    drawText(getLabelText(timeLabel, "Time: ", time), FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, -70);
+    drawText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM,
+        HorizontalAlignment::CENTER, 10);
+    drawText("[J] - Continue", FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM, HorizontalAlignment::CENTER, 30);
 }
 
 /**
  * @brief Renders the game over screen
  *
  * @param score Final game score
+ * @param winningScore Score needed to win the game
  * @param time Total game time string
  *
  * Displays:
@@ -135,22 +300,22 @@ void ScreenManager::drawPauseScreen(int score, std::string time)
  * - Total time played
  * - Option to return to menu
  */
-void ScreenManager::drawGameOverScreen(int score, std::string time)
+void ScreenManager::drawGameOverScreen(int score, int winningScore, const std::string &time)
 {
-    TextUtils::drawAlignedText("GAME OVER", FontManager::FONT_MAIN, 60, DARKGRAY, VerticalAlignment::CENTER,
-        HorizontalAlignment::CENTER, -120);
-    TextUtils::drawAlignedText(("Score: " + std::to_string(score) + "/100").c_str(), FontManager::FONT_MAIN, 30,
-        DARKGRAY, VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -50);
-    TextUtils::drawAlignedText(("Time: " + time).c_str(), FontManager::FONT_MAIN, 30, DARKGRAY,
-        VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -70);
-    TextUtils::drawAlignedText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 30, DARKGRAY,
-        VerticalAlignment::CENTER, HorizontalAlignment::CENTER, 50);
+    drawText("GAME OVER", FontManager::FONT_MAIN, 60, VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -120);
+    drawText(getScoreText(score, winningScore), FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, -50);
+    drawText(getLabelText(timeLabel, "Time: ", time), FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, -70);
+    drawText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, 50);
 }
 
 /**
  * @brief Renders the victory screen
  *
  * @param score Final game score
+ * @param winningScore Score needed to win the game
  * @param time Total game time string
  *
  * Displays:
@@ -159,14 +324,84 @@ void ScreenManager::drawGameOverScreen(int score, std::string time)
  * - Total time played
  * - Option to return to menu
  */
-void ScreenManager::drawFinishedScreen(int score, std::string time)
+void ScreenManager::drawFinishedScreen(int score, int winningScore, const std::string &time)
 {
-    TextUtils::drawAlignedText("YOU WON, CONGRATULATIONS!", FontManager::FONT_MAIN, 60, DARKGRAY,
-        VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -120);
-    TextUtils::drawAlignedText(("Score: " + std::to_string(score) + "/100").c_str(), FontManager::FONT_MAIN, 30,
-        DARKGRAY, VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -50);
-    TextUtils::drawAlignedText(("Time: " + time).c_str(), FontManager::FONT_MAIN, 30, DARKGRAY,
-        VerticalAlignment::CENTER, HorizontalAlignment::CENTER, -70);
-    TextUtils::drawAlignedText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 30, DARKGRAY,
-        VerticalAlignment::CENTER, HorizontalAlignment::CENTER, 50);
+    drawText("YOU WON, CONGRATULATIONS!", FontManager::FONT_MAIN, 60, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, -120);
+    drawText(getScoreText(score, winningScore), FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, -50);
+    drawText(getLabelText(timeLabel, "Time: ", time), FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, -70);
+    drawText("[SPACE] - Quit to main menu", FontManager::FONT_MAIN, 30, VerticalAlignment::CENTER,
+        HorizontalAlignment::CENTER, 50);
+}
+
+/**
+ * @brief Renders the seed of the current game
+ *
+ * @param seed Seed of the current game
+ *
+ * Shown in the bottom right corner on every screen, so a game can be
+ * reproduced by starting it with the same seed.
+ */
+void ScreenManager::drawSeedInfo(uint64_t seed)
+{
+    if (seedText.empty() || seed != shownSeed) {
+        shownSeed = seed;
+        seedText = "Seed: " + std::to_string(seed);
+    }
+    drawText(seedText.c_str(), FontManager::FONT_MAIN, 20, VerticalAlignment::BOTTOM, HorizontalAlignment::RIGHT, 30);
+}
+
+/**
+ * @brief Renders the frame profiler overlay in the top left corner
+ *
+ * @param profiler Profiler with the timings of the last frames
+ *
+ * Displays one row per phase with its median, 99th percentile and maximum time over the
+ * recorded frames, followed by a bar graph of the phase's time in the most recent frames.
+ * The last row shows the draw calls issued for the board per frame.
+ * Bars are scaled to the phase's maximum, bars above its 99th percentile are red, so
+ * stutter frames and the phase causing them stand out.
+ *
+ * The whole overlay is drawn in one text pass; the distance field shader keeps the
+ * panel and the bars as they are, since their texture is opaque.
+ */
+void ScreenManager::drawProfilerOverlay(const FrameProfiler &profiler)
+{
+    const float fontSize = 18.0f;
+    const float rowHeight = 22.0f;
+    const float graphWidth = 120.0f;
+    const int graphFrames = std::min(profiler.getFrameCount(), (int) graphWidth);
+
+    Font font = fonts.getFont(FontManager::FONT_MAIN);
+    beginText();
+    Rectangle panel = {bounds.x + 10, bounds.y + 50, 520, rowHeight * (FrameProfiler::PHASE_COUNT + 2) + 8};
+    DrawRectangleRec(panel, Fade(BLACK, 0.75f));
+    DrawTextEx(font, TextFormat("last %d frames     p50     p99     max (ms)", profiler.getFrameCount()),
+        Vector2{panel.x + 8, panel.y + 4}, fontSize, 1, WHITE);
+
+    for (int i = 0; i < FrameProfiler::PHASE_COUNT; i++) {
+        ProfilerPhase phase = (ProfilerPhase) i;
+        PhaseStats stats = profiler.getStats(phase);
+        float y = panel.y + 4 + rowHeight * (i + 1);
+        DrawTextEx(font, FrameProfiler::getPhaseName(phase), Vector2{panel.x + 8, y}, fontSize, 1, WHITE);
+        DrawTextEx(font, TextFormat("%7.2f %7.2f %7.2f", stats.p50, stats.p99, stats.max), Vector2{panel.x + 140, y},
+            fontSize, 1, WHITE);
+
+        float graphX = panel.x + panel.width - graphWidth - 8;
+        for (int age = 0; age < graphFrames && stats.max > 0.0f; age++) {
+            float milliseconds = profiler.getMilliseconds(phase, age);
+            float barHeight = std::max(1.0f, (rowHeight - 4) * milliseconds / stats.max);
+            DrawRectangleRec(Rectangle{graphX + graphWidth - 1 - age, y + rowHeight - 4 - barHeight, 1, barHeight},
+                milliseconds > stats.p99 ? RED : GREEN);
+        }
+    }
+
+    PhaseStats drawCalls = profiler.getDrawCallStats();
+    float y = panel.y + 4 + rowHeight * (FrameProfiler::PHASE_COUNT + 1);
+    DrawTextEx(font, "draw calls", Vector2{panel.x + 8, y}, fontSize, 1, WHITE);
+    DrawTextEx(font, TextFormat("%7.0f %7.0f %7.0f", drawCalls.p50, drawCalls.p99, drawCalls.max),
+        Vector2{panel.x + 140, y}, fontSize, 1, WHITE);
+    endText();
 }
@@ -2,23 +2,32 @@
  * @file snake.cpp
  * @brief Implementation of the Snake class for the Evil Snake game
  *
- * This file defines the behavior of the snake, including movement, collision detection,
- * rendering, and game interactions such as eating food and resetting position.
+ * This file defines the behavior of the snake, including movement, collision detection
+ * and game interactions such as eating food and resetting position. It is part of the
+ * renderer-free simulation core; drawing the snake is done by the Game class.
  */
 
 #include "../include/snake.h"
 
 #include "../include/constants.h"
-#include "raylib.h"
+#include "../include/tracing.h"
 
 /**
  * @brief Constructs a Snake object with an initial position.
  *
  * @param position The starting position of the snake.
+ * @param grid The board the snake moves on, its cell count is the maximum length of the snake.
  */
-Snake::Snake(const Vector2 &position)
-    : speed(Constants::DEFAULT_SNAKE_SPEED), direction(Direction::NONE), body{position}
+Snake::Snake(const Position &position, const Grid &grid)
+    : grid(grid),
+      direction(Direction::NONE),
+      collided(false),
+      grew(false),
+      previousTail(position),
+      speed(Constants::DEFAULT_SNAKE_SPEED),
+      body(grid.getCellCount())
 {
+    body.assign(position);
 }
 
 /**
@@ -40,82 +49,104 @@ void Snake::setDirection(Direction dir)
     }
 }
 
+/**
+ * @brief Gets the current movement direction of the snake.
+ *
+ * @return Direction The direction the snake moves in on its next step.
+ */
+Direction Snake::getDirection() const { return direction; }
+
+/**
+ * @brief Checks whether the snake's next head position is on the food.
+ *
+ * @param head The position the head moves to.
+ * @param foodPosition The position of the food on the grid.
+ * @return true if the head reaches the food position, false otherwise.
+ */
+bool Snake::hasEaten(const Position &head, const Position &foodPosition) const { return head == foodPosition; }
+
 /**
  * @brief Moves the snake and checks if it has eaten food.
  *
- * Moves the snake in its current direction, handling screen wrapping.
+ * Moves the snake in its current direction, wrapping around the board edges.
  * If the snake eats food, it grows; otherwise, it moves normally.
  *
+ * The tail is dropped before the new head is added, so the fixed-capacity body never
+ * overflows, even when the snake covers the whole board.
+ *
+ * The occupancy bitboard holds the snake body and all walls. The vacated tail cell
+ * is cleared before the new head cell is tested, so that moving into the cell the
+ * tail just left is not a collision, and the head cell is set afterwards.
+ *
  * @param foodPosition The position of the food on the grid.
+ * @param occupancy Occupancy bitboard of the board, updated with the move.
  * @return true if the snake eats the food, false otherwise.
  */
-bool Snake::moveAndCheckForFood(const Vector2 &foodPosition)
+bool Snake::moveAndCheckForFood(const Position &foodPosition, Bitboard &occupancy)
 {
-    Vector2 head = body.front();
+    TraceScope trace("Snake::moveAndCheckForFood", "collision");
+    Position head = body.front();
+    int x = head.x;
+    int y = head.y;
 
     switch (direction) {
         case Direction::UP:
-            head.y -= Constants::CELL_SIZE;
+            y--;
             break;
         case Direction::DOWN:
-            head.y += Constants::CELL_SIZE;
+            y++;
             break;
         case Direction::LEFT:
-            head.x -= Constants::CELL_SIZE;
+            x--;
             break;
         case Direction::RIGHT:
-            head.x += Constants::CELL_SIZE;
+            x++;
             break;
         default:
             break;
     }
 
-    // Handle screen wrapping
-    head.x = (int) (head.x + GetScreenWidth()) % GetScreenWidth();
-    head.y = (int) (head.y + GetScreenHeight()) % GetScreenHeight();
-    body.insert(body.begin(), head);
+    head = grid.wrap(x, y);
 
-    bool ateFood = (head.x == foodPosition.x && head.y == foodPosition.y);
+    bool ateFood = hasEaten(head, foodPosition);
+    grew = ateFood;
+    previousTail = body.back();
     if (!ateFood) {
-        body.pop_back();
+        occupancy.reset(grid.getCellIndex(body.back()));
+        body.popBack();
     }
+    body.pushFront(head);
+
+    int headCell = grid.getCellIndex(head);
+    collided = occupancy.test(headCell);
+    occupancy.set(headCell);
     return ateFood;
 }
 
 /**
- * @brief Checks if the snake has collided with itself or a wall.
+ * @brief Checks if the snake has collided with itself or a wall during its last move.
  *
- * @param wallPositions Vector containing the positions of walls.
- * @return true if the snake collides with itself or a wall, false otherwise.
+ * @return true if the head entered a cell occupied by the body or a wall, false otherwise.
  */
-bool Snake::hasCollided(const std::vector<Vector2> &wallPositions) const
-{
-    // Check self-collision
-    for (size_t i = 1; i < body.size(); ++i) {
-        if (body[i].x == body.front().x && body[i].y == body.front().y) {
-            return true;
-        }
-    }
-
-    // Check wall collision
-    if (std::any_of(wallPositions.begin(), wallPositions.end(),
-            [&](const Vector2 &wall) { return wall.x == body.front().x && wall.y == body.front().y; })) {
-        return true;
-    }
-
-    return false;
-}
+bool Snake::hasCollided() const { return collided; }
 
 /**
- * @brief Draws the snake on the screen.
+ * @brief Gets the position a segment had before the last move.
+ *
+ * Every segment moves into the cell of the segment in front of it, so the previous
+ * position of a segment is the current position of the one behind it. The tail came
+ * from the cell it vacated, or did not move at all if the snake grew.
+ * Used by the renderer to interpolate between two ticks.
  *
- * The snake's head is colored green, while the body is a darker green.
+ * @param index 0 for the head up to body.size() - 1 for the tail.
+ * @return Position The segment's position before the last move.
  */
-void Snake::draw() const
+Position Snake::getPreviousPosition(int index) const
 {
-    for (size_t i = 0; i < body.size(); ++i) {
-        DrawRectangle(body[i].x, body[i].y, Constants::CELL_SIZE, Constants::CELL_SIZE, i == 0 ? GREEN : DARKGREEN);
+    if (index + 1 < body.size()) {
+        return body[index + 1];
     }
+    return grew ? body[index] : previousTail;
 }
 
 /**
@@ -123,8 +154,29 @@ void Snake::draw() const
  *
  * @param position The position to reset the snake to.
  */
-void Snake::resetToPosition(const Vector2 &position)
+void Snake::resetToPosition(const Position &position)
 {
-    body.assign(1, position);
+    body.assign(position);
     direction = Direction::RIGHT;
+    collided = false;
+    grew = false;
+    previousTail = position;
+}
+
+/**
+ * @brief Resets the snake to a given body and direction.
+ *
+ * @param positions The segments from the head to the tail, at least one.
+ * @param dir The direction the snake moves in on its next step.
+ */
+void Snake::resetToBody(const std::vector<Position> &positions, Direction dir)
+{
+    body.assign(positions.back());
+    for (int i = (int) positions.size() - 2; i >= 0; i--) {
+        body.pushFront(positions[i]);
+    }
+    direction = dir;
+    collided = false;
+    grew = false;
+    previousTail = positions.back();
 }
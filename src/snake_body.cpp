@@ -0,0 +1,92 @@
+/**
+ * @file snake_body.cpp
+ * @brief Implementation of the SnakeBody ring buffer
+ *
+ * The snake body is stored in a circular buffer that is allocated once with room
+ * for every cell of the board. Moving the snake prepends the new head and drops the
+ * tail by adjusting two indices, so a move costs O(1) and never allocates, instead
+ * of shifting the whole body like a vector front-insert does.
+ *
+ * Index 0 always refers to the head and size() - 1 to the tail.
+ */
+
+#include "../include/snake_body.h"
+
+/**
+ * @brief Constructs an empty body
+ *
+ * @param capacity Maximum number of segments, usually the number of cells on the board
+ */
+SnakeBody::SnakeBody(int capacity) : segments(capacity), headIndex(0), length(0) {}
+
+/**
+ * @brief Replaces the body with a single segment
+ *
+ * @param position Position of the only segment
+ */
+void SnakeBody::assign(const Position &position)
+{
+    headIndex = 0;
+    length = 1;
+    segments[0] = position;
+}
+
+/**
+ * @brief Adds a new head segment in front of the current head
+ *
+ * @param position Position of the new head, the body must not be full
+ */
+void SnakeBody::pushFront(const Position &position)
+{
+    headIndex = headIndex == 0 ? capacity() - 1 : headIndex - 1;
+    segments[headIndex] = position;
+    length++;
+}
+
+/**
+ * @brief Removes the tail segment
+ */
+void SnakeBody::popBack() { length--; }
+
+/**
+ * @brief Gets the head segment
+ *
+ * @return const Position& Position of the head
+ */
+const Position &SnakeBody::front() const { return segments[headIndex]; }
+
+/**
+ * @brief Gets the tail segment
+ *
+ * @return const Position& Position of the tail
+ */
+const Position &SnakeBody::back() const { return (*this)[length - 1]; }
+
+/**
+ * @brief Gets a segment by its distance from the head
+ *
+ * @param index 0 for the head up to size() - 1 for the tail
+ * @return const Position& Position of the segment
+ */
+const Position &SnakeBody::operator[](int index) const
+{
+    int segment = headIndex + index;
+    if (segment >= capacity()) {
+        segment -= capacity();
+    }
+    return segments[segment];
+}
+
+/**
+ * @brief Gets the number of segments
+ *
+ * @return int Length of the snake
+ */
+int SnakeBody::size() const { return length; }
+
+/**
+ * @brief Gets the maximum number of segments
+ *
+ * @return int Number of segments the buffer was allocated for
+ */
+int SnakeBody::capacity() const { return (int) segments.size(); }
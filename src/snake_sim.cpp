@@ -0,0 +1,362 @@
+/**
+ * @file snake_sim.cpp
+ * @brief Implementation of the SnakeSim class, the renderer-free simulation core
+ *
+ * This file contains the complete rule set of the Evil Snake game: moving the snake,
+ * eating food, colliding with walls or itself, winning and the periodic random game
+ * mode changes. It has no dependency on raylib, so the rules can be stepped as fast
+ * as the CPU allows, e.g. for bot evaluation or regression runs on headless machines.
+ * Time inside the simulation advances by the duration of one tick per step.
+ */
+
+#include "../include/snake_sim.h"
+
+#include "../include/spawn_utils.h"
+#include "../include/tracing.h"
+
+/**
+ * @brief Constructor for the SnakeSim class
+ *
+ * @param config Board size and rules of the game
+ * @param seed Seed for all randomness of the game, equal seeds and inputs give equal games
+ *
+ * Allocates all per-cell structures once for the configured board size,
+ * seeds the random number generator and sets up a fresh game.
+ */
+SnakeSim::SnakeSim(const GameConfig &config, uint64_t seed)
+    : config(config),
+      grid(config.cellAmountX, config.cellAmountY),
+      rng(seed),
+      status(SimStatus::RUNNING),
+      mode(GameMode::NORMAL),
+      snake(SpawnUtils::getRandomGridPosition(rng, grid), grid),
+      foodPosition{},
+      wallPositions{},
+      freeCells(grid.getCellCount()),
+      occupancy(grid.getCellCount()),
+      score(0),
+      ticks(0),
+      elapsedTime(0.0f),
+      timeSinceLastEventCheck(0.0f)
+{
+    wallPositions.reserve(config.wallAmount);
+    reset(seed);
+}
+
+/**
+ * @brief Resets the simulation to the start of a new game with the same seed
+ *
+ * Replays the exact same game as the previous reset when given the same inputs.
+ */
+void SnakeSim::reset() { reset(rng.getSeed()); }
+
+/**
+ * @brief Resets the simulation to the start of a new game
+ *
+ * @param seed Seed for all randomness of the new game
+ *
+ * Clears score, timers, walls, the free cell index and the occupancy grid, places the snake
+ * at a random position and spawns the first food item.
+ */
+void SnakeSim::reset(uint64_t seed)
+{
+    rng.reseed(seed);
+    status = SimStatus::RUNNING;
+    mode = GameMode::NORMAL;
+    score = 0;
+    ticks = 0;
+    elapsedTime = 0.0f;
+    timeSinceLastEventCheck = 0.0f;
+    wallPositions.clear();
+    freeCells.reset();
+    occupancy.clear();
+
+    snake.speed = config.defaultSnakeSpeed;
+    snake.resetToPosition(SpawnUtils::getRandomGridPosition(rng, grid));
+    int headCell = grid.getCellIndex(snake.body.front());
+    freeCells.occupy(headCell);
+    occupancy.set(headCell);
+    spawnFood();
+}
+
+/**
+ * @brief Places the food on a random free cell
+ *
+ * @return true if the food was placed, false if no free cell is left on the board
+ */
+bool SnakeSim::spawnFood()
+{
+    TraceScope trace("SnakeSim::spawnFood", "spawn");
+    std::optional<Position> position = SpawnUtils::getRandomFreePosition(rng, grid, freeCells);
+    if (!position) {
+        return false;
+    }
+
+    foodPosition = *position;
+    freeCells.occupy(grid.getCellIndex(foodPosition));
+    return true;
+}
+
+/**
+ * @brief Reseeds the random number generator without touching the board
+ *
+ * @param seed Seed for all randomness from now on
+ *
+ * The game continues from its current state, but food, walls and mode changes to come
+ * are drawn anew. Bots use this to sample possible futures of a game they cannot know.
+ */
+void SnakeSim::reseed(uint64_t seed) { rng.reseed(seed); }
+
+/**
+ * @brief Replaces the board with the state of a game that is only observed
+ *
+ * @param body Cells of the snake from the head to the tail, at least one
+ * @param dir Direction the snake moves in on its next step
+ * @param food Position of the food
+ * @param walls Positions of all walls, at most config.wallAmount
+ *
+ * Score, time and mode are left as they are. Bots use this to rebuild a game they read
+ * through the C API, so they can run their searches on it without knowing its seed.
+ */
+void SnakeSim::restore(const std::vector<Position> &body, Direction dir, const Position &food,
+    const std::vector<Position> &walls)
+{
+    status = SimStatus::RUNNING;
+    freeCells.reset();
+    occupancy.clear();
+    wallPositions.assign(walls.begin(), walls.end());
+    for (const Position &wallPosition : wallPositions) {
+        int wallCell = grid.getCellIndex(wallPosition);
+        freeCells.occupy(wallCell);
+        occupancy.set(wallCell);
+    }
+
+    snake.resetToBody(body, dir);
+    for (const Position &segment : body) {
+        int cell = grid.getCellIndex(segment);
+        freeCells.occupy(cell);
+        occupancy.set(cell);
+    }
+    foodPosition = food;
+    freeCells.occupy(grid.getCellIndex(foodPosition));
+}
+
+/**
+ * @brief Requests a new direction for the snake
+ *
+ * @param dir The new direction; reversing onto itself is ignored by the snake
+ */
+void SnakeSim::setDirection(Direction dir)
+{
+    if (dir != Direction::NONE) {
+        snake.setDirection(dir);
+    }
+}
+
+/**
+ * @brief Changes the current game mode randomly
+ *
+ * Switches between three possible modes:
+ * - NORMAL: Default snake speed, no walls
+ * - FAST: Increased snake speed, no walls
+ * - WALLS: Default speed with randomly placed wall obstacles
+ *
+ * Walls are only placed on free cells, so they never overlap the snake or the food.
+ *
+ * @return true if the mode actually changed, false if the same mode was drawn again
+ */
+bool SnakeSim::changeGameMode()
+{
+    TraceScope trace("SnakeSim::changeGameMode", "spawn");
+    static const GameMode gameModes[] = {GameMode::NORMAL, GameMode::FAST, GameMode::WALLS};
+    GameMode newMode = gameModes[rng.nextInt(0, 2)];
+
+    if (mode == newMode) return false;
+
+    mode = newMode;
+    snake.speed = (mode == GameMode::FAST) ? config.fastSnakeSpeed : config.defaultSnakeSpeed;
+
+    for (const Position &wallPosition : wallPositions) {
+        int wallCell = grid.getCellIndex(wallPosition);
+        freeCells.release(wallCell);
+        occupancy.reset(wallCell);
+    }
+    wallPositions.clear();
+
+    if (mode == GameMode::WALLS) {
+        for (int i = 0; i < config.wallAmount; i++) {
+            std::optional<Position> position = SpawnUtils::getRandomFreePosition(rng, grid, freeCells);
+            if (!position) break;
+
+            int wallCell = grid.getCellIndex(*position);
+            wallPositions.push_back(*position);
+            freeCells.occupy(wallCell);
+            occupancy.set(wallCell);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Advances the simulation by exactly one tick
+ *
+ * @param dir Direction input for this tick, Direction::NONE keeps the current direction
+ * @return StepResult Events that happened during the tick, used by the caller for sounds and state changes
+ *
+ * Handles:
+ * - Triggering game mode changes
+ * - Moving the snake
+ * - Managing food collection
+ * - Detecting collisions
+ * - Checking for the win condition, which includes filling the whole board
+ *
+ * The free cell index and the occupancy grid are updated incrementally with the cells
+ * the snake enters and leaves, so collision detection is a single bit test.
+ */
+StepResult SnakeSim::step(Direction dir)
+{
+    StepResult result;
+    if (status != SimStatus::RUNNING) {
+        return result;
+    }
+
+    TraceScope trace("SnakeSim::step", "sim");
+    setDirection(dir);
+
+    float tickDuration = snake.speed;
+    ticks++;
+    elapsedTime += tickDuration;
+    timeSinceLastEventCheck += tickDuration;
+
+    if (timeSinceLastEventCheck >= config.eventInterval) {
+        timeSinceLastEventCheck = 0.0f;
+        result.modeChanged = changeGameMode();
+    }
+
+    Position tail = snake.body.back();
+    bool ateFood = snake.moveAndCheckForFood(foodPosition, occupancy);
+    if (!ateFood) {
+        freeCells.release(grid.getCellIndex(tail));
+    }
+    freeCells.occupy(grid.getCellIndex(snake.body.front()));
+
+    bool boardFull = false;
+    if (ateFood) {
+        result.ateFood = true;
+        score++;
+        boardFull = !spawnFood();
+    }
+
+    if (snake.hasCollided()) {
+        result.collided = true;
+        status = SimStatus::GAME_OVER;
+        return result;
+    }
+
+    if (score >= config.winningScore || boardFull) {
+        result.finished = true;
+        status = SimStatus::FINISHED;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Gets the configuration the simulation was created with
+ *
+ * @return const GameConfig& Board size and rules
+ */
+const GameConfig &SnakeSim::getConfig() const { return config; }
+
+/**
+ * @brief Gets the board of the simulation
+ *
+ * @return const Grid& Board dimensions and cell index conversion
+ */
+const Grid &SnakeSim::getGrid() const { return grid; }
+
+/**
+ * @brief Gets the seed of the current game
+ *
+ * @return uint64_t Seed passed to the last reset
+ */
+uint64_t SnakeSim::getSeed() const { return rng.getSeed(); }
+
+/**
+ * @brief Gets the current status of the simulation
+ *
+ * @return SimStatus RUNNING while the game is in progress, otherwise how it ended
+ */
+SimStatus SnakeSim::getStatus() const { return status; }
+
+/**
+ * @brief Gets the active game mode
+ *
+ * @return GameMode The current game mode
+ */
+GameMode SnakeSim::getMode() const { return mode; }
+
+/**
+ * @brief Gets the snake
+ *
+ * @return const Snake& Read-only access to the snake, e.g. for rendering
+ */
+const Snake &SnakeSim::getSnake() const { return snake; }
+
+/**
+ * @brief Gets the position of the current food item
+ *
+ * @return const Position& The food position
+ */
+const Position &SnakeSim::getFoodPosition() const { return foodPosition; }
+
+/**
+ * @brief Gets the positions of all walls
+ *
+ * @return const std::vector<Position>& Wall positions, empty outside of WALLS mode
+ */
+const std::vector<Position> &SnakeSim::getWallPositions() const { return wallPositions; }
+
+/**
+ * @brief Gets the occupancy grid of the snake body and the walls
+ *
+ * @return const Bitboard& One bit per cell, set for every cell the snake or a wall occupies
+ */
+const Bitboard &SnakeSim::getOccupancy() const { return occupancy; }
+
+/**
+ * @brief Checks whether a cell is occupied by the snake or a wall
+ *
+ * @param position Cell position on the board
+ * @return true if entering the cell would be a collision, false otherwise
+ */
+bool SnakeSim::isBlocked(const Position &position) const { return occupancy.test(grid.getCellIndex(position)); }
+
+/**
+ * @brief Gets the current score
+ *
+ * @return int Number of food items eaten
+ */
+int SnakeSim::getScore() const { return score; }
+
+/**
+ * @brief Gets the number of ticks simulated since the last reset
+ *
+ * @return long Tick count
+ */
+long SnakeSim::getTicks() const { return ticks; }
+
+/**
+ * @brief Gets the simulated game time since the last reset
+ *
+ * @return float Sum of all tick durations in seconds
+ */
+float SnakeSim::getElapsedTime() const { return elapsedTime; }
+
+/**
+ * @brief Gets the duration of the next tick
+ *
+ * @return float Seconds between two snake moves in the current mode
+ */
+float SnakeSim::getTickDuration() const { return snake.speed; }
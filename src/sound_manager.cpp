@@ -3,6 +3,8 @@
  * @brief Implementation of the SoundManager class for the Evil Snake game
  *
  * This file manages game sound effects, including loading, playing, and cleanup of sounds.
+ * A SoundManager is the audio context of the process: it owns the audio device, so exactly
+ * one instance should exist at a time and all games share it.
  */
 
 #include "../include/sound_manager.h"
@@ -10,6 +12,7 @@
 #include <raylib.h>
 
 #include "../include/game_utils.h"
+#include "../include/tracing.h"
 
 /**
  * @brief Sound effect identifiers
@@ -35,17 +38,6 @@ SoundManager::~SoundManager()
     CloseAudioDevice();
 }
 
-/**
- * @brief Gets the singleton instance of the SoundManager.
- *
- * @return Reference to the SoundManager instance.
- */
-SoundManager &SoundManager::getInstance()
-{
-    static SoundManager instance;
-    return instance;
-}
-
 /**
  * @brief Loads sound effects into memory.
  *
@@ -53,6 +45,7 @@ SoundManager &SoundManager::getInstance()
  */
 void SoundManager::initSounds()
 {
+    TraceScope trace("SoundManager::initSounds", "asset");
     sounds[SOUND_EAT] = LoadSound(TextFormat("%ssounds/eat.wav", GameUtils::getAssetPath().c_str()));
     sounds[SOUND_EXPLOSION] = LoadSound(TextFormat("%ssounds/explosion.wav", GameUtils::getAssetPath().c_str()));
     sounds[SOUND_START] = LoadSound(TextFormat("%ssounds/start.wav", GameUtils::getAssetPath().c_str()));
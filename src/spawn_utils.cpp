@@ -0,0 +1,43 @@
+/**
+ * @file spawn_utils.cpp
+ * @brief Implementation of the spawning helpers used by the simulation core
+ *
+ * This file provides the random placement of the snake, food and walls on the
+ * game grid. All randomness is drawn from the generator passed in by the caller,
+ * so these helpers do not depend on raylib or any global state.
+ */
+
+#include "../include/spawn_utils.h"
+
+/**
+ * @brief Generates a random position on the game grid
+ *
+ * @param rng Random number generator to draw from
+ * @param grid The board to place the position on
+ * @return Position Random cell position on the board
+ */
+Position SpawnUtils::getRandomGridPosition(Random &rng, const Grid &grid)
+{
+    int x = rng.nextInt(0, grid.getWidth() - 1);
+    int y = rng.nextInt(0, grid.getHeight() - 1);
+    return {(int16_t) x, (int16_t) y};
+}
+
+/**
+ * @brief Generates a random position on a cell that is neither snake, wall nor food
+ *
+ * @param rng Random number generator to draw from
+ * @param grid The board to place the position on
+ * @param freeCells Index of all currently unoccupied cells
+ * @return std::optional<Position> Random free position, or std::nullopt if the board is full
+ *
+ * Runs in constant time regardless of how much of the board is occupied.
+ */
+std::optional<Position> SpawnUtils::getRandomFreePosition(Random &rng, const Grid &grid, const FreeCellIndex &freeCells)
+{
+    int cell = freeCells.getRandomFreeCell(rng);
+    if (cell < 0) {
+        return std::nullopt;
+    }
+    return grid.getCellPosition(cell);
+}
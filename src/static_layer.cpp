@@ -0,0 +1,138 @@
+/**
+ * @file static_layer.cpp
+ * @brief Implementation of the StaticLayer class, a cached layer of the board
+ *
+ * Parts of the board that rarely change, like the background grid or the walls, are
+ * drawn once into a render texture and then copied to the screen with a single textured
+ * quad per frame, instead of issuing their draw calls again every frame. A layer is
+ * redrawn when it is invalidated, e.g. because the walls changed, or when it needs a
+ * different size, e.g. after the view changed.
+ *
+ * Layers store premultiplied colors: while redrawing, the alpha channel is accumulated
+ * separately from the colors, and the layer is blended with premultiplied alpha when it
+ * is drawn. Opaque content looks the same either way, but semi-transparent pixels such as
+ * anti-aliased text edges keep their coverage instead of being faded twice.
+ *
+ * A layer whose content changes in a few places can instead be updated in place, which
+ * overwrites only the drawn pixels and keeps the rest of its content.
+ *
+ * Layers are redrawn outside of any scissor mode, since the scissor rectangle of the
+ * screen would also clip drawing into the texture.
+ */
+
+#include "../include/static_layer.h"
+
+#include "rlgl.h"
+
+/**
+ * @brief Constructor for the StaticLayer class
+ *
+ * The texture is created on the first redraw, so layers can be constructed before the window exists.
+ */
+StaticLayer::StaticLayer() : target(), loaded(false), valid(false) {}
+
+/**
+ * @brief Destructor, unloads the texture
+ */
+StaticLayer::~StaticLayer()
+{
+    if (loaded) {
+        UnloadRenderTexture(target);
+    }
+}
+
+/**
+ * @brief Checks whether the layer has to be redrawn before it can be drawn at a size
+ *
+ * @param width Width of the layer in texture pixels
+ * @param height Height of the layer in texture pixels
+ * @return true if the layer was invalidated, never drawn or has a different size
+ */
+bool StaticLayer::needsRedraw(int width, int height) const
+{
+    return !valid || target.texture.width != width || target.texture.height != height;
+}
+
+/**
+ * @brief Starts drawing the content of the layer into its texture
+ *
+ * @param width Width of the layer in texture pixels, the texture is recreated if it changed
+ * @param height Height of the layer in texture pixels
+ *
+ * The texture is cleared to transparent. All following draw calls go into the texture
+ * until endRedraw(), with the texture's top left corner as origin, and are blended into
+ * premultiplied colors.
+ */
+void StaticLayer::beginRedraw(int width, int height)
+{
+    if (!loaded || target.texture.width != width || target.texture.height != height) {
+        if (loaded) {
+            UnloadRenderTexture(target);
+        }
+        target = LoadRenderTexture(width, height);
+        SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);
+        loaded = true;
+    }
+
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    rlSetBlendFactorsSeparate(
+        RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+/**
+ * @brief Finishes drawing the content of the layer, it is valid until invalidated
+ */
+void StaticLayer::endRedraw()
+{
+    EndBlendMode();
+    EndTextureMode();
+    valid = true;
+}
+
+/**
+ * @brief Starts overwriting parts of the valid content of the layer
+ *
+ * Unlike beginRedraw(), the texture keeps its content and drawn colors replace the pixels
+ * instead of being blended onto them, so drawing BLANK erases a pixel. Only opaque colors
+ * and BLANK keep the content premultiplied. All following draw
+ * calls go into the texture until endUpdate(). The layer must not need a redraw.
+ */
+void StaticLayer::beginUpdate()
+{
+    BeginTextureMode(target);
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+}
+
+/**
+ * @brief Finishes overwriting parts of the layer and restores the default blending
+ */
+void StaticLayer::endUpdate()
+{
+    EndBlendMode();
+    EndTextureMode();
+}
+
+/**
+ * @brief Marks the content of the layer as outdated, it is redrawn before it is drawn next
+ */
+void StaticLayer::invalidate() { valid = false; }
+
+/**
+ * @brief Draws a part of the layer to the screen
+ *
+ * @param source Part of the layer in texture pixels, with the origin in the top left corner
+ * @param destination Screen area to draw it into, the part is scaled to fit
+ *
+ * Render textures are stored upside down, so the source is flipped vertically here.
+ */
+void StaticLayer::draw(Rectangle source, Rectangle destination) const
+{
+    source.y = target.texture.height - source.y - source.height;
+    source.height = -source.height;
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexturePro(target.texture, source, destination, Vector2{0, 0}, 0.0f, WHITE);
+    EndBlendMode();
+}
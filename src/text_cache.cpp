@@ -0,0 +1,100 @@
+/**
+ * @file text_cache.cpp
+ * @brief Implementation of the TextCache class, which remembers measured text sizes
+ *
+ * Aligning a text requires its size, and MeasureTextEx walks all glyphs of the text for
+ * that every time. UI texts rarely change between frames, so the cache keeps the measured
+ * size per text, font and font size. A lookup hashes the text and compares it with the
+ * cached one, so it neither allocates nor measures after the first frame a text is shown.
+ *
+ * The cache is a fixed table of Constants::TEXT_CACHE_CAPACITY entries, where the hash
+ * selects the only entry a text can be stored in. Texts such as the elapsed time change
+ * every frame and just overwrite entries instead of growing the cache. Overwriting reuses
+ * the memory of the entry's text, so once every entry held its longest text the cache
+ * does not allocate anymore.
+ */
+
+#include "../include/text_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../include/constants.h"
+
+namespace
+{
+/**
+ * @brief Hashes a text together with the font and size it is drawn with (FNV-1a)
+ *
+ * @param text Null terminated text
+ * @param fontTexture Texture id of the font's glyph atlas, identifies the font
+ * @param fontSize Font size in pixels
+ * @return uint64_t Hash of all three values
+ */
+uint64_t hashText(const char *text, unsigned int fontTexture, float fontSize)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const char *c = text; *c != '\0'; c++) {
+        hash = (hash ^ (unsigned char) *c) * 1099511628211ull;
+    }
+    uint32_t sizeBits;
+    std::memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+    hash = (hash ^ fontTexture) * 1099511628211ull;
+    return (hash ^ sizeBits) * 1099511628211ull;
+}
+}  // namespace
+
+/**
+ * @brief Constructor for the TextCache class
+ */
+TextCache::TextCache() : entries(Constants::TEXT_CACHE_CAPACITY) { clear(); }
+
+/**
+ * @brief Gets the size of a text, measuring it only if it is not cached yet
+ *
+ * @param font Font the text is drawn with
+ * @param text Null terminated text
+ * @param fontSize Font size in pixels
+ * @return Vector2 Width and height of the text in pixels, as returned by MeasureTextEx
+ */
+Vector2 TextCache::measure(const Font &font, const char *text, float fontSize)
+{
+    uint64_t hash = hashText(text, font.texture.id, fontSize);
+    Entry &entry = entries[hash % entries.size()];
+    if (entry.hash == hash && entry.fontTexture == font.texture.id && entry.fontSize == fontSize &&
+        entry.text == text) {
+        return entry.size;
+    }
+
+    entry.hash = hash;
+    entry.text = text;
+    entry.fontTexture = font.texture.id;
+    entry.fontSize = fontSize;
+    entry.size = MeasureTextEx(font, text, fontSize, Constants::TEXT_SPACING);
+    return entry.size;
+}
+
+/**
+ * @brief Removes all cached sizes, e.g. after the fonts were reloaded
+ *
+ * The entries keep the memory of their texts.
+ */
+void TextCache::clear()
+{
+    for (Entry &entry : entries) {
+        entry.hash = 0;
+        entry.text.clear();
+        entry.fontSize = -1.0f;
+    }
+}
+
+/**
+ * @brief Returns the number of cached texts
+ *
+ * @return int Number of entries that hold a measured text
+ */
+int TextCache::getSize() const
+{
+    return (int) std::count_if(
+        entries.begin(), entries.end(), [](const Entry &entry) { return entry.fontSize >= 0.0f; });
+}
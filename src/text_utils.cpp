@@ -4,13 +4,12 @@
  *
  * This file provides functions for rendering text with alignment options.
  * It includes horizontal and vertical positioning logic to place text
- * correctly on the game window.
+ * correctly inside the screen area of a game, so several games can share one window.
  */
 
 #include "../include/text_utils.h"
 
 #include "../include/constants.h"
-#include "../include/font_manager.h"
 
 namespace
 {
@@ -18,21 +17,22 @@ namespace
  * @brief Computes the horizontal position for text rendering.
  *
  * @param alignment The desired horizontal alignment.
+ * @param bounds The screen area the text is aligned in.
  * @param textWidth The width of the text to be drawn.
  * @param padding Additional padding from the aligned edge.
  * @return float The computed x-coordinate for text positioning.
  */
-float computeHorizontalPosition(HorizontalAlignment alignment, float textWidth, float padding)
+float computeHorizontalPosition(HorizontalAlignment alignment, Rectangle bounds, float textWidth, float padding)
 {
     switch (alignment) {
         case HorizontalAlignment::RIGHT:
-            return Constants::WINDOW_WIDTH - textWidth - padding;
+            return bounds.x + bounds.width - textWidth - padding;
         case HorizontalAlignment::CENTER:
-            return (Constants::WINDOW_WIDTH - textWidth) / 2;
+            return bounds.x + (bounds.width - textWidth) / 2;
         case HorizontalAlignment::LEFT:
-            return padding;
+            return bounds.x + padding;
         default:
-            return padding;
+            return bounds.x + padding;
     }
 }
 
@@ -40,21 +40,22 @@ float computeHorizontalPosition(HorizontalAlignment alignment, float textWidth,
  * @brief Computes the vertical position for text rendering.
  *
  * @param alignment The desired vertical alignment.
+ * @param bounds The screen area the text is aligned in.
  * @param fontSize The font size of the text.
  * @param padding Additional padding from the aligned edge.
  * @return float The computed y-coordinate for text positioning.
  */
-float computeVerticalPosition(VerticalAlignment alignment, float fontSize, float padding)
+float computeVerticalPosition(VerticalAlignment alignment, Rectangle bounds, float fontSize, float padding)
 {
     switch (alignment) {
         case VerticalAlignment::BOTTOM:
-            return Constants::WINDOW_HEIGHT - fontSize - padding;
+            return bounds.y + bounds.height - fontSize - padding;
         case VerticalAlignment::CENTER:
-            return (Constants::WINDOW_HEIGHT - fontSize) / 2 + padding;
+            return bounds.y + (bounds.height - fontSize) / 2 + padding;
         case VerticalAlignment::TOP:
-            return padding;
+            return bounds.y + padding;
         default:
-            return padding;
+            return bounds.y + padding;
     }
 }
 
@@ -64,23 +65,42 @@ float computeVerticalPosition(VerticalAlignment alignment, float fontSize, float
  * @brief Draws text with alignment options.
  *
  * @param text The text string to render.
- * @param fontId The ID of the font to use.
+ * @param font The font to use.
+ * @param bounds The screen area the text is aligned in.
  * @param fontSize The font size to render the text.
  * @param color The color of the text.
  * @param verticalAlignment The vertical alignment of the text.
  * @param horizontalAlignment The horizontal alignment of the text.
  * @param padding Additional padding from the aligned edge.
  */
-void TextUtils::drawAlignedText(const char *text, int fontId, float fontSize, Color color,
+void TextUtils::drawAlignedText(const char *text, const Font &font, Rectangle bounds, float fontSize, Color color,
     VerticalAlignment verticalAlignment, HorizontalAlignment horizontalAlignment, float padding)
 {
-    Font font = FontManager::getInstance().getFont(fontId);
-    Vector2 textSize = MeasureTextEx(font, text, fontSize, 2);
+    Vector2 textSize = MeasureTextEx(font, text, fontSize, Constants::TEXT_SPACING);
+    drawMeasuredText(text, font, textSize, bounds, fontSize, color, verticalAlignment, horizontalAlignment, padding);
+}
 
+/**
+ * @brief Draws text with alignment options, using a size measured before.
+ *
+ * @param text The text string to render.
+ * @param font The font to use.
+ * @param textSize The size of the text, e.g. from a TextCache.
+ * @param bounds The screen area the text is aligned in.
+ * @param fontSize The font size to render the text.
+ * @param color The color of the text.
+ * @param verticalAlignment The vertical alignment of the text.
+ * @param horizontalAlignment The horizontal alignment of the text.
+ * @param padding Additional padding from the aligned edge.
+ */
+void TextUtils::drawMeasuredText(const char *text, const Font &font, Vector2 textSize, Rectangle bounds,
+    float fontSize, Color color, VerticalAlignment verticalAlignment, HorizontalAlignment horizontalAlignment,
+    float padding)
+{
     Vector2 position = {
-        computeHorizontalPosition(horizontalAlignment, textSize.x, padding),
-        computeVerticalPosition(verticalAlignment, textSize.y, padding),
+        computeHorizontalPosition(horizontalAlignment, bounds, textSize.x, padding),
+        computeVerticalPosition(verticalAlignment, bounds, textSize.y, padding),
     };
 
-    DrawTextEx(font, text, position, fontSize, 2, color);
+    DrawTextEx(font, text, position, fontSize, Constants::TEXT_SPACING, color);
 }
@@ -0,0 +1,177 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation of the ThreadPool class, a small work-stealing pool for batch jobs
+ *
+ * parallelFor() splits an index range evenly across all workers. Each worker takes
+ * indices from the front of its own range; once that is empty it steals the back half
+ * of the largest remaining range of another worker. Uneven items, like replays of very
+ * different length, are thereby balanced without a shared queue that every item has
+ * to pass through. The calling thread works as worker 0, so a pool of one thread
+ * starts no threads at all.
+ */
+
+#include "../include/thread_pool.h"
+
+#include <algorithm>
+
+/**
+ * @brief Constructor for the ThreadPool class, starts the worker threads
+ *
+ * @param threadCount Number of threads working on a job including the caller, at least 1
+ */
+ThreadPool::ThreadPool(int threadCount)
+    : threads(),
+      ranges(),
+      workerCount(std::max(threadCount, 1)),
+      job(nullptr),
+      generation(0),
+      busyWorkers(0),
+      stopping(false)
+{
+    ranges = std::make_unique<WorkRange[]>(workerCount);
+    threads.reserve(workerCount - 1);
+    for (int worker = 1; worker < workerCount; worker++) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+/**
+ * @brief Destructor, stops and joins all worker threads
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Gets the number of threads working on a job, including the caller
+ */
+int ThreadPool::getThreadCount() const { return workerCount; }
+
+/**
+ * @brief Calls a function for every index in [0, count) using all workers
+ *
+ * @param count Number of items
+ * @param fn Function called with the item index and the index of the worker running it,
+ *           calls with the same worker index never run concurrently
+ *
+ * Returns once all items are done. Must not be called from inside a job.
+ */
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t index, int worker)> &fn)
+{
+    if (count == 0) return;
+
+    for (int worker = 0; worker < workerCount; worker++) {
+        std::lock_guard<std::mutex> lock(ranges[worker].mutex);
+        ranges[worker].begin = count * worker / workerCount;
+        ranges[worker].end = count * (worker + 1) / workerCount;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        busyWorkers = workerCount - 1;
+        generation++;
+    }
+    wakeCondition.notify_all();
+
+    runWorker(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+/**
+ * @brief Main loop of a worker thread, waits for jobs and runs them until the pool is destroyed
+ */
+void ThreadPool::workerLoop(int worker)
+{
+    unsigned long seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        runWorker(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) doneCondition.notify_one();
+    }
+}
+
+/**
+ * @brief Works on the current job until no worker has items left
+ */
+void ThreadPool::runWorker(int worker)
+{
+    size_t index;
+    do {
+        while (takeOwn(worker, index)) {
+            (*job)(index, worker);
+        }
+    } while (steal(worker));
+}
+
+/**
+ * @brief Takes the next item from the front of the worker's own range
+ *
+ * @return true if an item was taken
+ */
+bool ThreadPool::takeOwn(int worker, size_t &index)
+{
+    WorkRange &range = ranges[worker];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin >= range.end) return false;
+    index = range.begin++;
+    return true;
+}
+
+/**
+ * @brief Moves the back half of the largest other range into the worker's own range
+ *
+ * @return true if at least one item was stolen, false if all ranges are empty
+ */
+bool ThreadPool::steal(int worker)
+{
+    while (true) {
+        int victim = -1;
+        size_t largest = 0;
+        for (int other = 0; other < workerCount; other++) {
+            if (other == worker) continue;
+            std::lock_guard<std::mutex> lock(ranges[other].mutex);
+            size_t remaining = ranges[other].end - ranges[other].begin;
+            if (remaining > largest) {
+                largest = remaining;
+                victim = other;
+            }
+        }
+        if (victim < 0) return false;
+
+        size_t begin;
+        size_t end;
+        {
+            std::lock_guard<std::mutex> lock(ranges[victim].mutex);
+            WorkRange &range = ranges[victim];
+            if (range.begin >= range.end) continue;
+            end = range.end;
+            begin = range.end - (range.end - range.begin + 1) / 2;
+            range.end = begin;
+        }
+
+        std::lock_guard<std::mutex> lock(ranges[worker].mutex);
+        ranges[worker].begin = begin;
+        ranges[worker].end = end;
+        return true;
+    }
+}
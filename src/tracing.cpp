@@ -0,0 +1,227 @@
+/**
+ * @file tracing.cpp
+ * @brief Implementation of the trace recorder writing Chrome trace event files
+ *
+ * While a trace is running, every TraceScope and every Tracing::record() call adds a
+ * complete event with its name, category, thread and duration. The resulting JSON file
+ * opens in chrome://tracing and in the Perfetto UI.
+ *
+ * Events are collected per thread: each thread appends to its own buffer, guarded by a
+ * mutex that only the stop of a trace ever contends. Full buffers are handed to a writer
+ * thread, which formats and writes them to the file off the hot path and returns the
+ * emptied buffers for reuse. Recording an event therefore costs two clock reads, an
+ * uncontended lock and a copy into preallocated memory. Without a running trace, a scope
+ * only checks an atomic flag, inlined from the header.
+ *
+ * Event names and categories are not copied, they must be string literals.
+ */
+
+#include "../include/tracing.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct TraceEvent {
+    const char *name;
+    const char *category;
+    int64_t beginNanoseconds;
+    int64_t durationNanoseconds;
+    int threadId;
+};
+
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    int threadId = 0;
+};
+
+/**
+ * @brief Number of events a thread buffers before handing them to the writer thread
+ */
+constexpr size_t BUFFER_EVENTS = 16384;
+
+std::chrono::steady_clock::time_point origin;
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+std::mutex writerMutex;
+std::condition_variable writerCondition;
+std::vector<std::vector<TraceEvent>> fullBuffers;
+std::vector<std::vector<TraceEvent>> freeBuffers;
+std::thread writerThread;
+bool writerStopping = false;
+FILE *traceFile = nullptr;
+bool firstEvent = true;
+
+/**
+ * @brief Gets an empty event buffer, reusing one the writer thread has emptied if possible
+ *
+ * Must be called with writerMutex held.
+ */
+std::vector<TraceEvent> takeFreeBuffer()
+{
+    std::vector<TraceEvent> buffer;
+    if (!freeBuffers.empty()) {
+        buffer = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+    }
+    buffer.reserve(BUFFER_EVENTS);
+    return buffer;
+}
+
+/**
+ * @brief Gets the buffer of the calling thread, registering the thread on its first event
+ */
+ThreadBuffer &getThreadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threadBuffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = threadBuffers.back().get();
+        buffer->threadId = (int) threadBuffers.size();
+        buffer->events.reserve(BUFFER_EVENTS);
+    }
+    return *buffer;
+}
+
+/**
+ * @brief Writes a batch of events to the trace file
+ */
+void writeEvents(const std::vector<TraceEvent> &events)
+{
+    for (const TraceEvent &event : events) {
+        std::fprintf(traceFile,
+            "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+            firstEvent ? "" : ",", event.name, event.category, event.beginNanoseconds / 1000.0,
+            event.durationNanoseconds / 1000.0, event.threadId);
+        firstEvent = false;
+    }
+}
+
+/**
+ * @brief Writer thread, writes full buffers to the file until the trace stops
+ */
+void writerLoop()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true) {
+        writerCondition.wait(lock, []() { return !fullBuffers.empty() || writerStopping; });
+        if (fullBuffers.empty()) return;
+
+        std::vector<TraceEvent> buffer = std::move(fullBuffers.back());
+        fullBuffers.pop_back();
+        lock.unlock();
+        writeEvents(buffer);
+        buffer.clear();
+        lock.lock();
+        freeBuffers.push_back(std::move(buffer));
+    }
+}
+}  // namespace
+
+std::atomic<bool> Tracing::enabled(false);
+
+/**
+ * @brief Starts recording a trace into a file
+ *
+ * @param path Trace file to create, an existing file is replaced
+ * @return true if the file was created, false if it cannot be written or a trace is already running
+ */
+bool Tracing::start(const std::string &path)
+{
+    if (enabled.load() || traceFile != nullptr) return false;
+
+    traceFile = std::fopen(path.c_str(), "w");
+    if (traceFile == nullptr) return false;
+
+    std::fprintf(traceFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    firstEvent = true;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const std::unique_ptr<ThreadBuffer> &buffer : threadBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        for (std::vector<TraceEvent> &buffer : fullBuffers) {
+            buffer.clear();
+            freeBuffers.push_back(std::move(buffer));
+        }
+        fullBuffers.clear();
+        writerStopping = false;
+    }
+    origin = std::chrono::steady_clock::now();
+    writerThread = std::thread(writerLoop);
+    enabled.store(true);
+    return true;
+}
+
+/**
+ * @brief Stops the running trace, writes all buffered events and closes the file
+ *
+ * Events of scopes still open at this point are dropped.
+ */
+void Tracing::stop()
+{
+    if (!enabled.exchange(false)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        for (const std::unique_ptr<ThreadBuffer> &buffer : threadBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            if (buffer->events.empty()) continue;
+
+            fullBuffers.push_back(std::move(buffer->events));
+            buffer->events = takeFreeBuffer();
+        }
+        writerStopping = true;
+    }
+    writerCondition.notify_one();
+    writerThread.join();
+
+    std::fprintf(traceFile, "\n]}\n");
+    std::fclose(traceFile);
+    traceFile = nullptr;
+}
+
+/**
+ * @brief Records a complete event of the calling thread if a trace is running
+ *
+ * @param name Name of the event, must be a string literal
+ * @param category Category of the event, must be a string literal
+ * @param begin Time the event began
+ * @param end Time the event ended
+ */
+void Tracing::record(const char *name, const char *category, std::chrono::steady_clock::time_point begin,
+    std::chrono::steady_clock::time_point end)
+{
+    if (!isEnabled()) return;
+
+    ThreadBuffer &buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(TraceEvent{name, category,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(begin - origin).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(), buffer.threadId});
+    if (buffer.events.size() < BUFFER_EVENTS) return;
+
+    {
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        fullBuffers.push_back(std::move(buffer.events));
+        buffer.events = takeFreeBuffer();
+    }
+    writerCondition.notify_one();
+}
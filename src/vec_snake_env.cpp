@@ -0,0 +1,202 @@
+/**
+ * @file vec_snake_env.cpp
+ * @brief Implementation of the VecSnakeEnv class, a batch of independent games for bot training
+ *
+ * A VecSnakeEnv steps N games with the same board and rules in one call. Every game is
+ * a regular SnakeSim, so agents trained here see exactly the rules of the real game.
+ * Everything that crosses the batch boundary is laid out as structure of arrays:
+ * actions, rewards, done flags, scores and episode lengths are one array each, and the
+ * observations of all games are a single contiguous buffer of one byte per cell.
+ *
+ * Games are stepped in chunks of consecutive games, optionally spread across a
+ * ThreadPool. Finished games are reset automatically with the next seed of their own
+ * seed sequence, so a batch is reproducible from its seed independently of the thread count.
+ */
+
+#include "../include/vec_snake_env.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr int ENVS_PER_CHUNK = 64;
+}  // namespace
+
+/**
+ * @brief Constructor for the VecSnakeEnv class
+ *
+ * @param envCount Number of games in the batch
+ * @param config Board size and rules shared by all games
+ * @param seed Seed of the whole batch, every game derives its own seed sequence from it
+ * @param threadCount Threads used for stepping, 1 steps on the calling thread only
+ *
+ * Allocates all games and buffers once; stepping does not allocate.
+ */
+VecSnakeEnv::VecSnakeEnv(int envCount, const GameConfig &config, uint64_t seed, int threadCount)
+    : config(config),
+      envCount(std::max(envCount, 1)),
+      cellCount(config.cellAmountX * config.cellAmountY),
+      sims(),
+      seedGenerators(),
+      observations((size_t) this->envCount * cellCount),
+      rewards(this->envCount, 0.0f),
+      dones(this->envCount, 0),
+      scores(this->envCount, 0),
+      episodeTicks(this->envCount, 0),
+      pool(threadCount > 1 ? std::make_unique<ThreadPool>(threadCount) : nullptr)
+{
+    Random seeder(seed);
+    sims.reserve(this->envCount);
+    seedGenerators.reserve(this->envCount);
+    for (int env = 0; env < this->envCount; env++) {
+        seedGenerators.emplace_back(seeder.next());
+        sims.emplace_back(config, seedGenerators[env].next());
+    }
+    reset();
+}
+
+/**
+ * @brief Starts a new episode in every game and writes the first observations
+ */
+void VecSnakeEnv::reset()
+{
+    for (int env = 0; env < envCount; env++) {
+        resetEnv(env);
+        rewards[env] = 0.0f;
+        dones[env] = 0;
+    }
+}
+
+/**
+ * @brief Advances every game by one tick
+ *
+ * @param actions One direction per game, Direction::NONE keeps the current direction
+ *
+ * Afterwards the reward of a game is 1 for eating, -1 for colliding and 0 otherwise.
+ * For games that ended in this tick the done flag is set, score and episode length are
+ * those of the ended episode and the observation already shows the next episode.
+ */
+void VecSnakeEnv::step(const Direction *actions)
+{
+    int chunkCount = (envCount + ENVS_PER_CHUNK - 1) / ENVS_PER_CHUNK;
+    if (!pool || chunkCount == 1) {
+        stepRange(0, envCount, actions);
+        return;
+    }
+    pool->parallelFor(chunkCount, [&](size_t chunk, int) {
+        int begin = (int) chunk * ENVS_PER_CHUNK;
+        stepRange(begin, std::min(begin + ENVS_PER_CHUNK, envCount), actions);
+    });
+}
+
+/**
+ * @brief Steps the games [begin, end) and writes their results
+ */
+void VecSnakeEnv::stepRange(int begin, int end, const Direction *actions)
+{
+    for (int env = begin; env < end; env++) {
+        SnakeSim &sim = sims[env];
+        StepResult result = sim.step(actions[env]);
+
+        rewards[env] = result.collided ? -1.0f : (result.ateFood ? 1.0f : 0.0f);
+        scores[env] = sim.getScore();
+        episodeTicks[env] = (int32_t) sim.getTicks();
+        dones[env] = sim.getStatus() != SimStatus::RUNNING;
+
+        if (dones[env]) {
+            sim.reset(seedGenerators[env].next());
+        }
+        writeObservation(sim, &observations[(size_t) env * cellCount]);
+    }
+}
+
+/**
+ * @brief Starts a new episode in a single game
+ */
+void VecSnakeEnv::resetEnv(int env)
+{
+    sims[env].reset(seedGenerators[env].next());
+    scores[env] = 0;
+    episodeTicks[env] = 0;
+    writeObservation(sims[env], &observations[(size_t) env * cellCount]);
+}
+
+/**
+ * @brief Writes the board of a game as one ObservationCell byte per cell in row-major order
+ *
+ * @param sim Game to observe
+ * @param out Buffer of at least width * height bytes
+ *
+ * The occupancy bitboard is expanded word by word into body cells, then walls, food
+ * and the head are written over it.
+ */
+void VecSnakeEnv::writeObservation(const SnakeSim &sim, uint8_t *out)
+{
+    const Grid &grid = sim.getGrid();
+    const std::vector<uint64_t> &words = sim.getOccupancy().getWords();
+    int cells = grid.getCellCount();
+
+    for (int word = 0; word * 64 < cells; word++) {
+        uint64_t bits = words[word];
+        int count = std::min(64, cells - word * 64);
+        uint8_t *wordOut = out + word * 64;
+        for (int bit = 0; bit < count; bit++) {
+            wordOut[bit] = (uint8_t) ((bits >> bit) & 1);
+        }
+    }
+
+    for (const Position &wallPosition : sim.getWallPositions()) {
+        out[grid.getCellIndex(wallPosition)] = (uint8_t) ObservationCell::WALL;
+    }
+    out[grid.getCellIndex(sim.getFoodPosition())] = (uint8_t) ObservationCell::FOOD;
+    out[grid.getCellIndex(sim.getSnake().body.front())] = (uint8_t) ObservationCell::SNAKE_HEAD;
+}
+
+/**
+ * @brief Gets the number of games in the batch
+ */
+int VecSnakeEnv::getEnvCount() const { return envCount; }
+
+/**
+ * @brief Gets the number of cells of a single observation
+ */
+int VecSnakeEnv::getCellCount() const { return cellCount; }
+
+/**
+ * @brief Gets the board size and rules shared by all games
+ */
+const GameConfig &VecSnakeEnv::getConfig() const { return config; }
+
+/**
+ * @brief Gets a single game of the batch
+ *
+ * @param env Index of the game
+ */
+const SnakeSim &VecSnakeEnv::getSim(int env) const { return sims[env]; }
+
+/**
+ * @brief Gets the observations of all games
+ *
+ * @return const uint8_t* envCount * cellCount bytes, the board of game i starts at i * cellCount
+ */
+const uint8_t *VecSnakeEnv::getObservations() const { return observations.data(); }
+
+/**
+ * @brief Gets the reward of every game for the last step
+ */
+const float *VecSnakeEnv::getRewards() const { return rewards.data(); }
+
+/**
+ * @brief Gets whether every game ended in the last step, 1 if so, 0 otherwise
+ */
+const uint8_t *VecSnakeEnv::getDones() const { return dones.data(); }
+
+/**
+ * @brief Gets the score of every game, of the ended episode if it ended in the last step
+ */
+const int32_t *VecSnakeEnv::getScores() const { return scores.data(); }
+
+/**
+ * @brief Gets the number of ticks of every game's episode, of the ended episode if it ended in the last step
+ */
+const int32_t *VecSnakeEnv::getEpisodeTicks() const { return episodeTicks.data(); }
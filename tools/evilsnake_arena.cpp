@@ -0,0 +1,436 @@
+/**
+ * @file evilsnake_arena.cpp
+ * @brief Command line tool that ranks bot plugins by playing them on many seeds
+ *
+ * Bots are shared libraries implementing the plugin interface of evilsnake_bot.h. Every
+ * bot plays the same seeds of the deterministic libevilsnake game, so a ranking can be
+ * reproduced exactly. Each game runs in its own forked worker process that reports its
+ * result through a pipe: a bot that crashes or exceeds the time limit only loses that
+ * game, not the tournament. Bots read the game only through the C API and are not given
+ * the seed, which decides where food will spawn.
+ *
+ * The ranking orders the bots by their rate of games won, i.e. games that reached the
+ * winning score, then by the mean in-game time they took to win. It also lists the mean
+ * score, the ticks per second of the bot and game together and how the other games ended.
+ *
+ * Usage: evilsnake-arena <bot.so>... [--games <count>] [--first-seed <seed>] [--jobs <count>]
+ *        [--timeout <seconds>] [--max-ticks <count>] [--config <file>]
+ * Exits with 0 if all games were played, 1 on invalid arguments or bots that cannot be loaded.
+ */
+
+#include <dlfcn.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/evilsnake.h"
+#include "../include/evilsnake_bot.h"
+#include "../include/game_config.h"
+
+namespace
+{
+enum class Outcome {
+    FINISHED,
+    GAME_OVER,
+    STALLED,
+    TIMEOUT,
+    CRASHED,
+};
+
+struct Bot {
+    std::string path;
+    std::string name;
+    EvilSnakeBotCreateFunction create = nullptr;
+    EvilSnakeBotChooseFunction choose = nullptr;
+    EvilSnakeBotDestroyFunction destroy = nullptr;
+};
+
+struct ArenaOptions {
+    std::vector<std::string> botPaths;
+    int games = 100;
+    uint64_t firstSeed = 1;
+    int jobs = std::max((int) std::thread::hardware_concurrency(), 1);
+    double timeout = 60.0;
+    long maxTicks = 1'000'000;
+    GameConfig config;
+};
+
+struct GameResult {
+    int32_t status = EVILSNAKE_STATUS_ERROR;
+    int32_t score = 0;
+    int64_t ticks = 0;
+    float elapsedTime = 0.0f;
+    double seconds = 0.0;
+};
+
+struct Match {
+    int bot = 0;
+    uint64_t seed = 0;
+    Outcome outcome = Outcome::CRASHED;
+    GameResult result;
+};
+
+struct Worker {
+    pid_t pid = -1;
+    int fd = -1;
+    size_t match = 0;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+struct Ranking {
+    int bot = 0;
+    int games = 0;
+    int counts[5] = {};
+    long score = 0;
+    double completionTime = 0.0;
+    long ticks = 0;
+    double seconds = 0.0;
+
+    double getWinRate() const { return games > 0 ? (double) counts[(int) Outcome::FINISHED] / games : 0.0; }
+    double getMeanCompletionTime() const
+    {
+        int wins = counts[(int) Outcome::FINISHED];
+        return wins > 0 ? completionTime / wins : 0.0;
+    }
+};
+
+/**
+ * @brief Prints the command line usage of the arena
+ */
+void printUsage(const char *program)
+{
+    std::fprintf(stderr,
+        "Usage: %s <bot.so>... [--games <count>] [--first-seed <seed>] [--jobs <count>] [--timeout <seconds>]\n"
+        "       [--max-ticks <count>] [--config <file>]\n",
+        program);
+}
+
+/**
+ * @brief Parses the command line into the arena options
+ *
+ * @return true if the arguments are valid and name at least one bot
+ */
+bool parseArguments(ArenaOptions &options, int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--games") == 0 && hasValue) {
+            options.games = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--first-seed") == 0 && hasValue) {
+            options.firstSeed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--jobs") == 0 && hasValue) {
+            options.jobs = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(argv[i], "--timeout") == 0 && hasValue) {
+            options.timeout = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-ticks") == 0 && hasValue) {
+            options.maxTicks = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--config") == 0 && hasValue) {
+            if (!ConfigLoader::loadFromFile(options.config, argv[++i])) return false;
+        } else if (argv[i][0] != '-') {
+            options.botPaths.push_back(argv[i]);
+        } else {
+            return false;
+        }
+    }
+    return !options.botPaths.empty() && options.games > 0 && options.timeout > 0.0 && options.maxTicks > 0 &&
+           ConfigLoader::validate(options.config);
+}
+
+/**
+ * @brief Converts the game configuration into the configuration of the C API
+ */
+EvilSnakeConfig toEvilSnakeConfig(const GameConfig &config)
+{
+    EvilSnakeConfig evilSnakeConfig;
+    evilSnakeConfig.board_width = config.cellAmountX;
+    evilSnakeConfig.board_height = config.cellAmountY;
+    evilSnakeConfig.winning_score = config.winningScore;
+    evilSnakeConfig.wall_amount = config.wallAmount;
+    evilSnakeConfig.default_speed = config.defaultSnakeSpeed;
+    evilSnakeConfig.fast_speed = config.fastSnakeSpeed;
+    evilSnakeConfig.event_interval = config.eventInterval;
+    return evilSnakeConfig;
+}
+
+/**
+ * @brief Loads a bot plugin and checks its ABI version
+ *
+ * The plugin stays loaded for the lifetime of the arena, the workers inherit it when forked.
+ *
+ * @return true if the plugin exports the complete interface in the arena's ABI version
+ */
+bool loadBot(const std::string &path, Bot &bot)
+{
+    void *library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr) {
+        std::fprintf(stderr, "Cannot load %s: %s\n", path.c_str(), dlerror());
+        return false;
+    }
+
+    auto abiVersion = (EvilSnakeBotAbiVersionFunction) dlsym(library, "evilsnake_bot_abi_version");
+    auto name = (EvilSnakeBotNameFunction) dlsym(library, "evilsnake_bot_name");
+    bot.path = path;
+    bot.create = (EvilSnakeBotCreateFunction) dlsym(library, "evilsnake_bot_create");
+    bot.choose = (EvilSnakeBotChooseFunction) dlsym(library, "evilsnake_bot_choose");
+    bot.destroy = (EvilSnakeBotDestroyFunction) dlsym(library, "evilsnake_bot_destroy");
+    if (abiVersion == nullptr || name == nullptr || bot.create == nullptr || bot.choose == nullptr ||
+        bot.destroy == nullptr) {
+        std::fprintf(stderr, "%s does not implement the bot interface\n", path.c_str());
+        return false;
+    }
+    if (abiVersion() != EVILSNAKE_BOT_ABI_VERSION) {
+        std::fprintf(stderr, "%s was built for bot ABI version %u, expected %d\n", path.c_str(), abiVersion(),
+            EVILSNAKE_BOT_ABI_VERSION);
+        return false;
+    }
+    bot.name = name();
+    return true;
+}
+
+/**
+ * @brief Plays one game of a bot, runs inside a worker process
+ *
+ * @return GameResult Final state of the game, status EVILSNAKE_STATUS_ERROR if the game or bot could not be created
+ * or the bot chose an invalid direction
+ */
+GameResult playGame(const Bot &bot, const EvilSnakeConfig &config, uint64_t seed, long maxTicks)
+{
+    GameResult result;
+    EvilSnake *game = evilsnake_create(&config, seed);
+    EvilSnakeBot *player = game != nullptr ? bot.create(&config) : nullptr;
+    if (player == nullptr) {
+        evilsnake_destroy(game);
+        return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    EvilSnakeStepResult step = {};
+    int32_t status;
+    do {
+        status = evilsnake_step(game, bot.choose(player, game), &step);
+    } while (status == EVILSNAKE_STATUS_RUNNING && step.ticks < maxTicks);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.status = status;
+    result.score = step.score;
+    result.ticks = step.ticks;
+    result.elapsedTime = step.elapsed_time;
+    bot.destroy(player);
+    evilsnake_destroy(game);
+    return result;
+}
+
+/**
+ * @brief Forks a worker process that plays one match and writes its result into a pipe
+ *
+ * @return Worker Running worker, its pid is -1 if the process could not be started
+ */
+Worker startWorker(const std::vector<Bot> &bots, const ArenaOptions &options, const std::vector<Match> &matches,
+    size_t matchIndex)
+{
+    Worker worker;
+    int fds[2];
+    if (pipe(fds) != 0) return worker;
+
+    const Match &match = matches[matchIndex];
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        GameResult result =
+            playGame(bots[match.bot], toEvilSnakeConfig(options.config), match.seed, options.maxTicks);
+        bool written = write(fds[1], &result, sizeof(result)) == (ssize_t) sizeof(result);
+        _exit(written && result.status != EVILSNAKE_STATUS_ERROR ? 0 : 1);
+    }
+
+    close(fds[1]);
+    if (pid < 0) {
+        close(fds[0]);
+        return worker;
+    }
+
+    worker.pid = pid;
+    worker.fd = fds[0];
+    worker.match = matchIndex;
+    worker.deadline = std::chrono::steady_clock::now() +
+                      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(options.timeout));
+    return worker;
+}
+
+/**
+ * @brief Collects the result of a worker whose pipe became readable or closed
+ */
+void finishWorker(const Worker &worker, Match &match)
+{
+    GameResult result;
+    bool received = read(worker.fd, &result, sizeof(result)) == (ssize_t) sizeof(result);
+    close(worker.fd);
+
+    int status = 0;
+    waitpid(worker.pid, &status, 0);
+    if (!received || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        match.outcome = Outcome::CRASHED;
+        return;
+    }
+
+    match.result = result;
+    if (result.status == EVILSNAKE_STATUS_FINISHED) {
+        match.outcome = Outcome::FINISHED;
+    } else if (result.status == EVILSNAKE_STATUS_GAME_OVER) {
+        match.outcome = Outcome::GAME_OVER;
+    } else {
+        match.outcome = Outcome::STALLED;
+    }
+}
+
+/**
+ * @brief Kills a worker that exceeded the time limit
+ */
+void killWorker(const Worker &worker, Match &match)
+{
+    kill(worker.pid, SIGKILL);
+    waitpid(worker.pid, nullptr, 0);
+    close(worker.fd);
+    match.outcome = Outcome::TIMEOUT;
+}
+
+/**
+ * @brief Plays all matches with at most options.jobs worker processes at a time
+ */
+void playMatches(const std::vector<Bot> &bots, const ArenaOptions &options, std::vector<Match> &matches)
+{
+    std::vector<Worker> workers;
+    std::vector<pollfd> fds;
+    size_t nextMatch = 0;
+    while (nextMatch < matches.size() || !workers.empty()) {
+        while (nextMatch < matches.size() && (int) workers.size() < options.jobs) {
+            size_t matchIndex = nextMatch++;
+            Worker worker = startWorker(bots, options, matches, matchIndex);
+            if (worker.pid < 0) {
+                matches[matchIndex].outcome = Outcome::CRASHED;
+                continue;
+            }
+            workers.push_back(worker);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto nextDeadline = now + std::chrono::hours(1);
+        fds.clear();
+        for (const Worker &worker : workers) {
+            fds.push_back(pollfd{worker.fd, POLLIN, 0});
+            nextDeadline = std::min(nextDeadline, worker.deadline);
+        }
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(nextDeadline - now).count() + 1;
+        poll(fds.data(), fds.size(), (int) std::max<long>(wait, 0));
+
+        now = std::chrono::steady_clock::now();
+        for (size_t i = workers.size(); i-- > 0;) {
+            Worker &worker = workers[i];
+            if (fds[i].revents != 0) {
+                finishWorker(worker, matches[worker.match]);
+            } else if (now >= worker.deadline) {
+                killWorker(worker, matches[worker.match]);
+            } else {
+                continue;
+            }
+            workers.erase(workers.begin() + i);
+        }
+    }
+}
+
+/**
+ * @brief Sums up the matches of every bot and sorts the bots by win rate, then by mean completion time
+ */
+std::vector<Ranking> rankBots(size_t botCount, const std::vector<Match> &matches)
+{
+    std::vector<Ranking> rankings(botCount);
+    for (size_t i = 0; i < botCount; i++) {
+        rankings[i].bot = (int) i;
+    }
+    for (const Match &match : matches) {
+        Ranking &ranking = rankings[match.bot];
+        ranking.games++;
+        ranking.counts[(int) match.outcome]++;
+        ranking.score += match.result.score;
+        ranking.ticks += match.result.ticks;
+        ranking.seconds += match.result.seconds;
+        if (match.outcome == Outcome::FINISHED) ranking.completionTime += match.result.elapsedTime;
+    }
+
+    std::stable_sort(rankings.begin(), rankings.end(), [](const Ranking &a, const Ranking &b) {
+        if (a.getWinRate() != b.getWinRate()) return a.getWinRate() > b.getWinRate();
+        return a.getMeanCompletionTime() < b.getMeanCompletionTime();
+    });
+    return rankings;
+}
+
+/**
+ * @brief Prints the ranking table
+ */
+void printRanking(const std::vector<Bot> &bots, const std::vector<Ranking> &rankings)
+{
+    std::printf("%4s  %-16s %6s %8s %10s %14s %12s %10s %8s %8s %8s\n", "rank", "bot", "games", "win rate",
+        "mean score", "mean win time", "ticks/s", "game overs", "stalled", "timeouts", "crashes");
+    for (size_t i = 0; i < rankings.size(); i++) {
+        const Ranking &ranking = rankings[i];
+        std::printf("%4zu  %-16s %6d %7.1f%% %10.1f %13.1fs %12.0f %10d %8d %8d %8d\n", i + 1,
+            bots[ranking.bot].name.c_str(), ranking.games, ranking.getWinRate() * 100.0,
+            ranking.games > 0 ? (double) ranking.score / ranking.games : 0.0, ranking.getMeanCompletionTime(),
+            ranking.seconds > 0.0 ? ranking.ticks / ranking.seconds : 0.0, ranking.counts[(int) Outcome::GAME_OVER],
+            ranking.counts[(int) Outcome::STALLED], ranking.counts[(int) Outcome::TIMEOUT],
+            ranking.counts[(int) Outcome::CRASHED]);
+    }
+}
+}  // namespace
+
+/**
+ * @brief Program entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Bot plugins and options
+ * @return int 0 if the tournament was played, 1 on invalid arguments or bots that cannot be loaded
+ */
+int main(int argc, char **argv)
+{
+    ArenaOptions options;
+    if (!parseArguments(options, argc, argv)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<Bot> bots(options.botPaths.size());
+    for (size_t i = 0; i < bots.size(); i++) {
+        if (!loadBot(options.botPaths[i], bots[i])) return 1;
+    }
+
+    std::vector<Match> matches;
+    for (size_t bot = 0; bot < bots.size(); bot++) {
+        for (int game = 0; game < options.games; game++) {
+            Match match;
+            match.bot = (int) bot;
+            match.seed = options.firstSeed + game;
+            matches.push_back(match);
+        }
+    }
+
+    std::fflush(stdout);
+    auto start = std::chrono::steady_clock::now();
+    playMatches(bots, options, matches);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printRanking(bots, rankBots(bots.size(), matches));
+    std::printf("%zu games on seeds %llu to %llu, %d jobs, %.3f s\n", matches.size(),
+        (unsigned long long) options.firstSeed, (unsigned long long) (options.firstSeed + options.games - 1),
+        options.jobs, seconds);
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file replay_verifier.cpp
+ * @brief Command line tool that verifies a directory of recorded replays
+ *
+ * Every replay is simulated again with the deterministic SnakeSim and the outcome its
+ * inputs actually lead to is compared with the ticks, score, time and status the
+ * recording claims. The replays are spread across all cores with a work-stealing
+ * ThreadPool. Prints every mismatch and the throughput in replays and ticks per second.
+ *
+ * Replays are untrusted input, and a crafted header could claim a board of up to
+ * Constants::MAX_CELL_AMOUNT cells per side, whose simulation state takes hundreds of
+ * megabytes per thread. Replays with more than --max-cells cells, by default
+ * Constants::MAX_VERIFIED_CELL_COUNT, are reported as unreadable without simulating them.
+ * The same holds for replays that claim more than --max-ticks ticks, by default
+ * Constants::MAX_VERIFIED_TICKS. A few hundred bytes of runs can encode far more ticks,
+ * so the playback also stops shortly after the claimed tick count, which is a mismatch.
+ *
+ * Usage: replay_verifier <directory> [--threads <count>] [--max-cells <count>] [--max-ticks <count>]
+ * Exits with 0 if all replays are valid, 1 otherwise.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/constants.h"
+#include "../include/replay.h"
+#include "../include/thread_pool.h"
+
+namespace
+{
+enum class Verdict {
+    VALID,
+    MISMATCH,
+    UNREADABLE,
+};
+
+struct Verification {
+    Verdict verdict = Verdict::UNREADABLE;
+    ReplayOutcome claimed;
+    ReplayOutcome actual;
+};
+
+/**
+ * @brief Gets the printable name of a simulation status
+ */
+const char *getStatusName(SimStatus status)
+{
+    switch (status) {
+        case SimStatus::RUNNING:
+            return "running";
+        case SimStatus::GAME_OVER:
+            return "game over";
+        case SimStatus::FINISHED:
+            return "finished";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Collects all replay files of a directory, sorted by path
+ */
+std::vector<std::filesystem::path> findReplays(const std::filesystem::path &directory)
+{
+    std::vector<std::filesystem::path> paths;
+    for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".esr") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+/**
+ * @brief Loads and re-simulates a single replay
+ *
+ * @param path Path of the replay file
+ * @param maxCells Largest board in cells that is simulated, larger replays are unreadable
+ * @param maxTicks Largest claimed tick count that is simulated, longer replays are unreadable
+ */
+Verification verify(const std::filesystem::path &path, long maxCells, long maxTicks)
+{
+    Verification verification;
+    Replay replay;
+    if (!ReplayUtils::load(path.string(), replay)) return verification;
+    if ((long) replay.config.cellAmountX * replay.config.cellAmountY > maxCells) return verification;
+    if (replay.outcome.ticks < 0 || replay.outcome.ticks > maxTicks) return verification;
+
+    verification.claimed = replay.outcome;
+    verification.actual = ReplayUtils::simulate(replay, replay.outcome.ticks + Constants::VERIFIED_TICK_MARGIN);
+    verification.verdict = verification.actual == verification.claimed ? Verdict::VALID : Verdict::MISMATCH;
+    return verification;
+}
+
+/**
+ * @brief Prints the claimed and actual outcome of a replay that does not verify
+ */
+void printMismatch(const std::filesystem::path &path, const Verification &verification)
+{
+    const ReplayOutcome &claimed = verification.claimed;
+    const ReplayOutcome &actual = verification.actual;
+    std::printf("MISMATCH %s\n", path.string().c_str());
+    std::printf("  claimed: %ld ticks, score %d, %.3f s, %s\n", claimed.ticks, claimed.score, claimed.elapsedTime,
+        getStatusName(claimed.status));
+    std::printf("  actual:  %ld ticks, score %d, %.3f s, %s\n", actual.ticks, actual.score, actual.elapsedTime,
+        getStatusName(actual.status));
+}
+}  // namespace
+
+/**
+ * @brief Program entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Replay directory and options
+ * @return int 0 if all replays verify, 1 on mismatches, unreadable replays or invalid arguments
+ */
+int main(int argc, char **argv)
+{
+    int threadCount = std::max((int) std::thread::hardware_concurrency(), 1);
+    long maxCells = Constants::MAX_VERIFIED_CELL_COUNT;
+    long maxTicks = Constants::MAX_VERIFIED_TICKS;
+    const char *directory = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(argv[i], "--max-cells") == 0 && i + 1 < argc) {
+            maxCells = std::max(std::atol(argv[++i]), 4L);
+        } else if (std::strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc) {
+            maxTicks = std::max(std::atol(argv[++i]), 0L);
+        } else if (argv[i][0] != '-' && directory == nullptr) {
+            directory = argv[i];
+        } else {
+            directory = nullptr;
+            break;
+        }
+    }
+    if (directory == nullptr || !std::filesystem::is_directory(directory)) {
+        std::fprintf(stderr, "Usage: %s <directory> [--threads <count>] [--max-cells <count>] [--max-ticks <count>]\n",
+            argv[0]);
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> paths = findReplays(directory);
+    std::vector<Verification> verifications(paths.size());
+
+    ThreadPool pool(threadCount);
+    auto start = std::chrono::steady_clock::now();
+    pool.parallelFor(paths.size(), [&](size_t index, int) {
+        verifications[index] = verify(paths[index], maxCells, maxTicks);
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long ticks = 0;
+    int mismatches = 0;
+    int unreadable = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        const Verification &verification = verifications[i];
+        ticks += verification.actual.ticks;
+        if (verification.verdict == Verdict::MISMATCH) {
+            printMismatch(paths[i], verification);
+            mismatches++;
+        } else if (verification.verdict == Verdict::UNREADABLE) {
+            unreadable++;
+        }
+    }
+
+    std::printf("%zu replays, %d valid, %d mismatches, %d unreadable\n", paths.size(),
+        (int) paths.size() - mismatches - unreadable, mismatches, unreadable);
+    std::printf("%d threads, %.3f s, %.0f replays/s, %.0f ticks/s\n", pool.getThreadCount(), seconds,
+        seconds > 0.0 ? paths.size() / seconds : 0.0, seconds > 0.0 ? ticks / seconds : 0.0);
+    return mismatches == 0 && unreadable == 0 ? 0 : 1;
+}